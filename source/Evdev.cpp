@@ -0,0 +1,418 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Evdev.hpp"
+#include "InputSDL.hpp"
+
+#ifdef __linux__
+   #include <linux/input.h>
+   #include <fcntl.h>
+   #include <unistd.h>
+   #include <poll.h>
+   #include <dirent.h>
+   #include <sys/ioctl.h>
+   #include <ctime>
+   #include <cerrno>
+   #include <cstring>
+#endif
+
+
+DMeta TranslateKey(SDL_Scancode);
+DMeta TranslateMouse(Uint8);
+
+#ifdef __linux__
+/// Linux evdev key code -> SDL scancode translator                           
+/// Only keys that have a Langulus event are mapped                           
+///   @param code - the evdev key code                                        
+///   @return the scancode, or SDL_SCANCODE_UNKNOWN if not mapped             
+static SDL_Scancode TranslateEvdevKey(uint16_t code) {
+   switch (code) {
+   case KEY_A:             return SDL_SCANCODE_A;
+   case KEY_B:             return SDL_SCANCODE_B;
+   case KEY_C:             return SDL_SCANCODE_C;
+   case KEY_D:             return SDL_SCANCODE_D;
+   case KEY_E:             return SDL_SCANCODE_E;
+   case KEY_F:             return SDL_SCANCODE_F;
+   case KEY_G:             return SDL_SCANCODE_G;
+   case KEY_H:             return SDL_SCANCODE_H;
+   case KEY_I:             return SDL_SCANCODE_I;
+   case KEY_J:             return SDL_SCANCODE_J;
+   case KEY_K:             return SDL_SCANCODE_K;
+   case KEY_L:             return SDL_SCANCODE_L;
+   case KEY_M:             return SDL_SCANCODE_M;
+   case KEY_N:             return SDL_SCANCODE_N;
+   case KEY_O:             return SDL_SCANCODE_O;
+   case KEY_P:             return SDL_SCANCODE_P;
+   case KEY_Q:             return SDL_SCANCODE_Q;
+   case KEY_R:             return SDL_SCANCODE_R;
+   case KEY_S:             return SDL_SCANCODE_S;
+   case KEY_T:             return SDL_SCANCODE_T;
+   case KEY_U:             return SDL_SCANCODE_U;
+   case KEY_V:             return SDL_SCANCODE_V;
+   case KEY_W:             return SDL_SCANCODE_W;
+   case KEY_X:             return SDL_SCANCODE_X;
+   case KEY_Y:             return SDL_SCANCODE_Y;
+   case KEY_Z:             return SDL_SCANCODE_Z;
+
+   case KEY_1:             return SDL_SCANCODE_1;
+   case KEY_2:             return SDL_SCANCODE_2;
+   case KEY_3:             return SDL_SCANCODE_3;
+   case KEY_4:             return SDL_SCANCODE_4;
+   case KEY_5:             return SDL_SCANCODE_5;
+   case KEY_6:             return SDL_SCANCODE_6;
+   case KEY_7:             return SDL_SCANCODE_7;
+   case KEY_8:             return SDL_SCANCODE_8;
+   case KEY_9:             return SDL_SCANCODE_9;
+   case KEY_0:             return SDL_SCANCODE_0;
+
+   case KEY_ENTER:         return SDL_SCANCODE_RETURN;
+   case KEY_ESC:           return SDL_SCANCODE_ESCAPE;
+   case KEY_BACKSPACE:     return SDL_SCANCODE_BACKSPACE;
+   case KEY_TAB:           return SDL_SCANCODE_TAB;
+   case KEY_SPACE:         return SDL_SCANCODE_SPACE;
+   case KEY_MINUS:         return SDL_SCANCODE_MINUS;
+   case KEY_LEFTBRACE:     return SDL_SCANCODE_LEFTBRACKET;
+   case KEY_RIGHTBRACE:    return SDL_SCANCODE_RIGHTBRACKET;
+   case KEY_BACKSLASH:     return SDL_SCANCODE_BACKSLASH;
+   case KEY_SEMICOLON:     return SDL_SCANCODE_SEMICOLON;
+   case KEY_APOSTROPHE:    return SDL_SCANCODE_APOSTROPHE;
+   case KEY_GRAVE:         return SDL_SCANCODE_GRAVE;
+   case KEY_COMMA:         return SDL_SCANCODE_COMMA;
+   case KEY_DOT:           return SDL_SCANCODE_PERIOD;
+   case KEY_SLASH:         return SDL_SCANCODE_SLASH;
+   case KEY_102ND:         return SDL_SCANCODE_NONUSBACKSLASH;
+   case KEY_CAPSLOCK:      return SDL_SCANCODE_CAPSLOCK;
+
+   case KEY_F1:            return SDL_SCANCODE_F1;
+   case KEY_F2:            return SDL_SCANCODE_F2;
+   case KEY_F3:            return SDL_SCANCODE_F3;
+   case KEY_F4:            return SDL_SCANCODE_F4;
+   case KEY_F5:            return SDL_SCANCODE_F5;
+   case KEY_F6:            return SDL_SCANCODE_F6;
+   case KEY_F7:            return SDL_SCANCODE_F7;
+   case KEY_F8:            return SDL_SCANCODE_F8;
+   case KEY_F9:            return SDL_SCANCODE_F9;
+   case KEY_F10:           return SDL_SCANCODE_F10;
+   case KEY_F11:           return SDL_SCANCODE_F11;
+   case KEY_F12:           return SDL_SCANCODE_F12;
+
+   case KEY_SYSRQ:         return SDL_SCANCODE_PRINTSCREEN;
+   case KEY_SCROLLLOCK:    return SDL_SCANCODE_SCROLLLOCK;
+   case KEY_PAUSE:         return SDL_SCANCODE_PAUSE;
+   case KEY_INSERT:        return SDL_SCANCODE_INSERT;
+   case KEY_HOME:          return SDL_SCANCODE_HOME;
+   case KEY_PAGEUP:        return SDL_SCANCODE_PAGEUP;
+   case KEY_DELETE:        return SDL_SCANCODE_DELETE;
+   case KEY_END:           return SDL_SCANCODE_END;
+   case KEY_PAGEDOWN:      return SDL_SCANCODE_PAGEDOWN;
+   case KEY_RIGHT:         return SDL_SCANCODE_RIGHT;
+   case KEY_LEFT:          return SDL_SCANCODE_LEFT;
+   case KEY_DOWN:          return SDL_SCANCODE_DOWN;
+   case KEY_UP:            return SDL_SCANCODE_UP;
+
+   case KEY_NUMLOCK:       return SDL_SCANCODE_NUMLOCKCLEAR;
+   case KEY_KPSLASH:       return SDL_SCANCODE_KP_DIVIDE;
+   case KEY_KPASTERISK:    return SDL_SCANCODE_KP_MULTIPLY;
+   case KEY_KPMINUS:       return SDL_SCANCODE_KP_MINUS;
+   case KEY_KPPLUS:        return SDL_SCANCODE_KP_PLUS;
+   case KEY_KPENTER:       return SDL_SCANCODE_KP_ENTER;
+   case KEY_KP1:           return SDL_SCANCODE_KP_1;
+   case KEY_KP2:           return SDL_SCANCODE_KP_2;
+   case KEY_KP3:           return SDL_SCANCODE_KP_3;
+   case KEY_KP4:           return SDL_SCANCODE_KP_4;
+   case KEY_KP5:           return SDL_SCANCODE_KP_5;
+   case KEY_KP6:           return SDL_SCANCODE_KP_6;
+   case KEY_KP7:           return SDL_SCANCODE_KP_7;
+   case KEY_KP8:           return SDL_SCANCODE_KP_8;
+   case KEY_KP9:           return SDL_SCANCODE_KP_9;
+   case KEY_KP0:           return SDL_SCANCODE_KP_0;
+   case KEY_KPDOT:         return SDL_SCANCODE_KP_PERIOD;
+   case KEY_KPEQUAL:       return SDL_SCANCODE_KP_EQUALS;
+
+   case KEY_LEFTCTRL:      return SDL_SCANCODE_LCTRL;
+   case KEY_LEFTSHIFT:     return SDL_SCANCODE_LSHIFT;
+   case KEY_LEFTALT:       return SDL_SCANCODE_LALT;
+   case KEY_RIGHTCTRL:     return SDL_SCANCODE_RCTRL;
+   case KEY_RIGHTSHIFT:    return SDL_SCANCODE_RSHIFT;
+   case KEY_RIGHTALT:      return SDL_SCANCODE_RALT;
+   default:
+      return SDL_SCANCODE_UNKNOWN;
+   }
+}
+#endif
+
+/// Open a device for non-blocking reads                                      
+///   @param path - path to the device, or to a pipe or recorded stream       
+EvdevDevice::EvdevDevice(const Text& path)
+   : mPath {path} {
+   #ifdef __linux__
+      const auto terminated = mPath.Terminate();
+      mFile = ::open(terminated.GetRaw(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+      if (mFile < 0) {
+         Logger::Warning("Can't open input device ", mPath, ": ",
+            ::strerror(errno));
+         return;
+      }
+
+      // Devices stamp events with the wall clock by default, which can 
+      // jump - ask for the monotonic clock instead. Pipes and recorded 
+      // streams don't support this, their events stay in the wall clock
+      int clock = CLOCK_MONOTONIC;
+      mMonotonic = ::ioctl(mFile, EVIOCSCLOCKID, &clock) == 0;
+   #else
+      Logger::Warning("Can't open input device ", mPath,
+         ": evdev devices are available only on Linux");
+   #endif
+}
+
+/// Close the device                                                          
+EvdevDevice::~EvdevDevice() {
+   #ifdef __linux__
+      if (mFile >= 0)
+         ::close(mFile);
+   #endif
+}
+
+/// Check if the device is open and can be read from                          
+///   @return true if open                                                    
+bool EvdevDevice::IsOpen() const noexcept {
+   return mFile >= 0;
+}
+
+/// Get the path the device was opened from                                   
+///   @return the path                                                        
+const Text& EvdevDevice::GetPath() const noexcept {
+   return mPath;
+}
+
+
+/// Read and translate everything available in the device, without blocking   
+/// Events are read in batches, and are fed to the module like SDL events     
+///   @param module - the module to push translated events to                 
+///   @return the number of decoded input events                              
+Count EvdevDevice::Read(InputSDL& module) {
+   #ifdef __linux__
+      if (mFile < 0)
+         return 0;
+
+      constexpr Count EventSize = sizeof(input_event);
+      Count decoded = 0;
+      while (true) {
+         const auto bytes = ::read(mFile, mBuffer + mBuffered, BufferSize - mBuffered);
+         if (bytes < 0) {
+            if (errno == EINTR)
+               continue;
+
+            if (errno != EAGAIN and errno != EWOULDBLOCK) {
+               // Most likely the device was unplugged                  
+               Logger::Warning("Input device ", mPath, " failed: ",
+                  ::strerror(errno), " - closing it");
+               ::close(mFile);
+               mFile = -1;
+            }
+            break;
+         }
+
+         if (bytes == 0) {
+            // Real devices never end, so this is a closed pipe or the  
+            // end of a recorded stream - close it, so that it is not   
+            // reported as readable forever                             
+            VERBOSE_INPUT("Input stream ", mPath, " ended");
+            ::close(mFile);
+            mFile = -1;
+            break;
+         }
+
+         // Decode all whole events in the batch, converting the time   
+         // of each event from the device's clock to the SDL clock      
+         mBuffered += static_cast<Count>(bytes);
+         const auto now = SDL_GetTicksNS();
+         timespec source;
+         ::clock_gettime(mMonotonic ? CLOCK_MONOTONIC : CLOCK_REALTIME, &source);
+         const auto offset = static_cast<Sint64>(now)
+            - (static_cast<Sint64>(source.tv_sec) * 1000000000 + source.tv_nsec);
+
+         const auto whole = mBuffered / EventSize;
+         for (Offset i = 0; i < whole; ++i) {
+            input_event e;
+            ::memcpy(&e, mBuffer + i * EventSize, EventSize);
+
+            // Events without a time, or with a time that doesn't map   
+            // to the past, like in synthetic streams, happened now     
+            const auto time = static_cast<Sint64>(e.input_event_sec) * 1000000000
+                            + static_cast<Sint64>(e.input_event_usec) * 1000;
+            auto timestamp = now;
+            if (time > 0 and time + offset > 0 and time + offset <= static_cast<Sint64>(now))
+               timestamp = static_cast<Uint64>(time + offset);
+
+            Decode(module, e.type, e.code, e.value, timestamp);
+         }
+
+         // Carry a partially read event over to the next read          
+         const auto used = whole * EventSize;
+         mBuffered -= used;
+         if (mBuffered)
+            ::memmove(mBuffer, mBuffer + used, mBuffered);
+         decoded += whole;
+      }
+
+      return decoded;
+   #else
+      (void) module;
+      return 0;
+   #endif
+}
+
+/// Translate a single evdev event into Langulus events                       
+/// Relative motion is accumulated until the end of the report it belongs to  
+///   @param module - the module to push translated events to                 
+///   @param type - the evdev event type                                      
+///   @param code - the evdev event code                                      
+///   @param value - the evdev event value                                    
+///   @param timestamp - time of the event, in the SDL_GetTicksNS clock       
+void EvdevDevice::Decode(
+   InputSDL& module, uint16_t type, uint16_t code, int32_t value, Uint64 timestamp
+) {
+   #ifdef __linux__
+      switch (type) {
+      case EV_SYN:
+         if (code == SYN_DROPPED) {
+            // The kernel buffer overflowed - the report is incomplete  
+            mMotion = {};
+            mScroll = {};
+            mAbsoluteValid[0] = mAbsoluteValid[1] = false;
+            return;
+         }
+
+         if (code != SYN_REPORT)
+            return;
+
+         // End of a report - flush the accumulated motion              
+         if (mMotion) {
+            module.Move(0, mMotion, timestamp);
+            mMotion = {};
+         }
+         if (mScroll) {
+            module.Scroll(0, mScroll, timestamp);
+            mScroll = {};
+         }
+         return;
+
+      case EV_KEY: {
+         if (code == BTN_TOUCH) {
+            // Absolute axes are translated only while in contact       
+            mTouching = value != 0;
+            mAbsoluteValid[0] = mAbsoluteValid[1] = false;
+            return;
+         }
+
+         // Auto-repeats are dropped, like OS repeats of SDL keyboards  
+         if (value == 2)
+            return;
+
+         DMeta key;
+         if (code >= BTN_LEFT and code <= BTN_TASK)
+            key = TranslateMouse(static_cast<Uint8>(code - BTN_LEFT));
+         else {
+            const auto scancode = TranslateEvdevKey(code);
+            if (scancode == SDL_SCANCODE_UNKNOWN)
+               return;
+            key = TranslateKey(scancode);
+         }
+
+         ++module.GetMetrics().mCurrent.mDrained;
+         Event newEvent;
+         newEvent.mType = key;
+         newEvent.mState = value ? EventState::Begin : EventState::End;
+         module.PushEvent(newEvent, 0, timestamp);
+         return;
+      }
+
+      case EV_REL:
+         ++module.GetMetrics().mCurrent.mDrained;
+         if (code == REL_X)
+            mMotion.x += static_cast<float>(value);
+         else if (code == REL_Y)
+            mMotion.y += static_cast<float>(value);
+         else if (code == REL_WHEEL)
+            mScroll.y += static_cast<float>(value);
+         else if (code == REL_HWHEEL)
+            mScroll.x += static_cast<float>(value);
+         return;
+
+      case EV_ABS:
+         // Touchpads and tablets report absolute positions - these are 
+         // translated to relative motion while in contact. Analog      
+         // sticks never report contact, and aren't translated yet      
+         if (not mTouching or (code != ABS_X and code != ABS_Y))
+            return;
+
+         ++module.GetMetrics().mCurrent.mDrained;
+         if (mAbsoluteValid[code]) {
+            const auto delta = static_cast<float>(value - mAbsolute[code]);
+            if (code == ABS_X)
+               mMotion.x += delta;
+            else
+               mMotion.y += delta;
+         }
+
+         mAbsolute[code] = value;
+         mAbsoluteValid[code] = true;
+         return;
+      }
+   #else
+      (void) module; (void) type; (void) code; (void) value; (void) timestamp;
+   #endif
+}
+
+/// Find all evdev devices in the system                                      
+/// Reading them usually requires the user to be in the 'input' group         
+///   @return the paths to all /dev/input/event* devices                      
+TMany<Text> EvdevDevice::Scan() {
+   TMany<Text> paths;
+   #ifdef __linux__
+      const auto directory = ::opendir("/dev/input");
+      if (not directory)
+         return paths;
+
+      while (const auto entry = ::readdir(directory)) {
+         if (::strncmp(entry->d_name, "event", 5) == 0)
+            paths << Text {"/dev/input/"} + Text {entry->d_name};
+      }
+
+      ::closedir(directory);
+   #endif
+   return paths;
+}
+
+/// Wait until any of the devices has something to read                       
+///   @param devices - the devices to wait on                                 
+///   @param timeout - the longest time to wait, in milliseconds              
+///   @return true if at least one of the devices can be read from            
+bool EvdevDevice::Wait(const EvdevDevices& devices, Sint32 timeout) {
+   #ifdef __linux__
+      static constexpr Count MaxDevices = 64;
+      pollfd files[MaxDevices];
+      nfds_t count = 0;
+      for (auto pair : devices) {
+         if (pair.mValue->mFile >= 0 and count < MaxDevices)
+            files[count++] = {pair.mValue->mFile, POLLIN, 0};
+      }
+
+      // Never sleep on nothing - the caller should wait on SDL instead 
+      if (not count or ::poll(files, count, timeout) <= 0)
+         return false;
+
+      for (nfds_t i = 0; i < count; ++i) {
+         if (files[i].revents & POLLIN)
+            return true;
+      }
+   #else
+      (void) devices; (void) timeout;
+   #endif
+   return false;
+}
@@ -0,0 +1,69 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+struct EvdevDevice;
+using EvdevDevices = TUnorderedMap<Text, Ref<EvdevDevice>>;
+
+
+///                                                                           
+///   Linux evdev input device                                                
+///                                                                           
+/// Reads raw input events directly from a /dev/input/event* device, without  
+/// going through SDL, a window, or the desktop compositor - works even on    
+/// kiosk and console deployments without any desktop. Reads are batched and  
+/// non-blocking, and partially read events are carried over to the next      
+/// read, so any stream of input_event records can act as a device - a pipe   
+/// or a recorded stream can stand in for real hardware when testing.         
+/// Only available on Linux - on other platforms devices never open.          
+/// Devices are shared between the module and all gatherers that use them     
+///                                                                           
+struct EvdevDevice : Referenced {
+   // Size of the read buffer, in bytes                                 
+   static constexpr Count BufferSize = 4096;
+
+private:
+   // Path to the device, pipe, or recorded stream                      
+   Text mPath;
+   // File descriptor, -1 if not open                                   
+   int mFile = -1;
+   // Whether the device stamps events with the monotonic clock, instead
+   // of the wall clock                                                 
+   bool mMonotonic = false;
+
+   // Bytes that were read, but not yet decoded                         
+   uint8_t mBuffer[BufferSize];
+   Count mBuffered = 0;
+
+   // Relative motion and scroll, accumulated until the end of a report 
+   Math::Vec2f mMotion;
+   Math::Vec2f mScroll;
+
+   // Whether a touch or pen is in contact - absolute axes are then     
+   // translated to relative motion, like a touchpad                    
+   bool mTouching = false;
+   // Last absolute position while in contact, and validity of each axis
+   int mAbsolute[2] {};
+   bool mAbsoluteValid[2] {};
+
+   void Decode(InputSDL&, uint16_t, uint16_t, int32_t, Uint64);
+
+   Text Self() const { return mPath + ": "; }
+
+public:
+    EvdevDevice(const Text&);
+   ~EvdevDevice();
+
+   bool IsOpen() const noexcept;
+   const Text& GetPath() const noexcept;
+   Count Read(InputSDL&);
+
+   static TMany<Text> Scan();
+   static bool Wait(const EvdevDevices&, Sint32);
+};
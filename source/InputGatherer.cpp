@@ -16,29 +16,77 @@ InputGatherer::InputGatherer(InputSDL* producer, const Many& descriptor)
    : Resolvable   {this}
    , ProducedFrom {producer, descriptor} {
    VERBOSE_INPUT("Initializing...");
-   // Create an invisible window so that we can capture and track       
-   // the global mouse                                                  
-   mInputFocus = SDL_CreateWindow(
-      "Input Handle", 1, 1,
-      SDL_WINDOW_BORDERLESS | SDL_WINDOW_INPUT_FOCUS
-   );
-
-   if (not mInputFocus) {
-      // We're probably running without a desktop environment           
-      Logger::Warning(Self(),
-         "SDL failed to create input window - SDL won't be used for input. "
-         "The gatherer can still collect input from other modules, like FTXUI or GLFW. "
-         "SDL_Error: ", SDL_GetError()
-      );
-      Couple(descriptor);
-      VERBOSE_INPUT("Initialized");
-      return;
+   // Validate the windows provided in the descriptor, before anything  
+   // is acquired - a throwing constructor has no destructor to undo it 
+   descriptor.ForEachDeep([&](const InputWindow& window) {
+      LANGULUS_ASSERT(not producer->IsBound(window.mID), Construct,
+         "Window #", window.mID, " is already owned by another gatherer");
+      for (auto owned : mWindows) {
+         if (owned == window.mID)
+            return;
+      }
+      mWindows << window.mID;
+   });
+
+   bool requestedDevices = false;
+   descriptor.ForEachDeep([&](const InputDevice&) {
+      requestedDevices = true;
+   });
+
+   // Idle mode is module wide, but can be requested from here, since   
+   // gatherers are what scripts usually create                         
+   descriptor.ForEachDeep([&](const InputIdle& idle) {
+      producer->SetIdleTimeout(idle.mTimeout);
+   });
+
+   if (not mWindows and not requestedDevices) {
+      // Create an invisible window so that we can capture and track    
+      // the global mouse - the video subsystem is started only for it  
+      mVideo = producer->Acquire(SDL_INIT_VIDEO);
+      if (mVideo) {
+         mInputFocus = SDL_CreateWindow(
+            "Input Handle", 1, 1,
+            SDL_WINDOW_BORDERLESS | SDL_WINDOW_INPUT_FOCUS
+         );
+      }
+
+      if (not mInputFocus) {
+         // We're probably running without a desktop environment        
+         Logger::Warning(Self(),
+            "SDL failed to create input window - SDL won't be used for input. "
+            "The gatherer can still collect input from other modules, like FTXUI or GLFW. "
+            "SDL_Error: ", SDL_GetError()
+         );
+      }
+      else if (SDL_SetRelativeMouseMode(true) < 0) {
+         // Release the window and the subsystem before throwing        
+         const Text error = SDL_GetError();
+         SDL_DestroyWindow(mInputFocus);
+         producer->Release(SDL_INIT_VIDEO);
+         LANGULUS_ASSERT(false, Construct,
+            "SDL failed to set relative mouse mode. SDL_Error: ", error);
+      }
    }
 
-   LANGULUS_ASSERT(SDL_SetRelativeMouseMode(true) >= 0, Construct,
-      "SDL failed to set relative mouse mode. SDL_Error: ",
-      SDL_GetError()
-   );
+   // Claim the validated windows - nothing below throws                
+   for (auto window : mWindows)
+      producer->Bind(window, this);
+
+   // Read any devices provided in the descriptor directly              
+   descriptor.ForEachDeep([&](const InputDevice& device) {
+      auto opened = producer->OpenDevice(device.mPath);
+      if (opened)
+         mDevices << opened;
+   });
+
+   if (not mInputFocus and not mWindows and not requestedDevices) {
+      // No desktop and no explicit devices - read all devices directly 
+      for (auto& path : EvdevDevice::Scan()) {
+         auto opened = producer->OpenDevice(path);
+         if (opened)
+            mDevices << opened;
+      }
+   }
 
    Couple(descriptor);
    VERBOSE_INPUT("Initialized");
@@ -46,13 +94,46 @@ InputGatherer::InputGatherer(InputSDL* producer, const Many& descriptor)
 
 /// Shutdown the module                                                       
 InputGatherer::~InputGatherer() {
-   if (mInputFocus)
-      SDL_DestroyWindow(mInputFocus);
+   Detach();
+
+   // Discard any batches that were never consumed                      
+   auto batch = mIngested.exchange(nullptr, std::memory_order_acquire);
+   while (batch) {
+      std::unique_ptr<Batch> discarded {batch};
+      batch = discarded->mNext;
+   }
 }
 
-/// First stage destruction                                                   
+/// First stage destruction - detach while the module is still reachable,     
+/// since it might be gone by the time destructors run                        
 void InputGatherer::Teardown() {
    mListeners.Teardown();
+   Detach();
+}
+
+/// Release everything acquired from the module - subscriptions, windows,     
+/// devices and the video subsystem. Does nothing if already detached, or if  
+/// the module is gone, along with SDL                                        
+void InputGatherer::Detach() {
+   const auto module = GetProducer();
+   if (mDetached or not module)
+      return;
+
+   Subscribe(mActionMap, false);
+   for (auto window : mWindows)
+      module->Unbind(window);
+   for (auto& device : mDevices)
+      module->CloseDevice(device);
+   mDevices.Reset();
+
+   if (mInputFocus)
+      SDL_DestroyWindow(mInputFocus);
+   if (mVideo)
+      module->Release(SDL_INIT_VIDEO);
+
+   mInputFocus = nullptr;
+   mVideo = false;
+   mDetached = true;
 }
 
 /// Produce GUI elements in the system                                        
@@ -62,31 +143,309 @@ void InputGatherer::Create(Verb& verb) {
 }
 
 /// Interact with all listeners                                               
+/// Can be called from any thread - events are ingested as a single batch     
 ///   @param verb - interaction verb                                          
 void InputGatherer::Interact(Verb& verb) {
-   // Gather the relevant events                                        
+   // Gather the relevant events - this is the only copy they go        
+   // through, the batch is moved from here on, all the way into the    
+   // listeners' event queue                                            
+   TMany<Event> batch;
    verb.ForEachDeep([&](const Event& e) {
-      PushEvent(e);
-      verb.Done();
+      batch << e;
    });
+
+   if (batch) {
+      Ingest(std::move(batch));
+      verb.Done();
+   }
+}
+
+/// Ingest a batch of events without blocking - can be called from any        
+/// thread, the events will be consumed at the start of the next Update       
+///   @param events - the events to take ownership of                         
+void InputGatherer::Ingest(TMany<Event>&& events) {
+   if (not events)
+      return;
+
+   // The stack takes ownership of the batch, once it's pushed          
+   auto batch = std::make_unique<Batch>();
+   batch->mEvents = std::move(events);
+   batch->mNext = mIngested.load(std::memory_order_relaxed);
+   while (not mIngested.compare_exchange_weak(
+      batch->mNext, batch.get(),
+      std::memory_order_release, std::memory_order_relaxed
+   ));
+   batch.release();
+}
+
+/// Swap out all ingested batches and merge them into the event queue         
+/// Batches are pushed in a stack, so they're reversed to preserve order      
+void InputGatherer::Consume() {
+   auto batch = mIngested.exchange(nullptr, std::memory_order_acquire);
+   Batch* ordered = nullptr;
+   while (batch) {
+      const auto next = batch->mNext;
+      batch->mNext = ordered;
+      ordered = batch;
+      batch = next;
+   }
+
+   auto& metrics = GetProducer()->GetMetrics().mCurrent;
+   while (ordered) {
+      std::unique_ptr<Batch> batch {ordered};
+      ordered = batch->mNext;
+      ++metrics.mInsertions;
+      Merge(std::move(batch->mEvents));
+   }
+}
+
+/// Merge a whole batch into the event queue in a single pass - events are    
+/// moved in, and events of the same type and state merge their payloads      
+///   @param events - the events to merge                                     
+void InputGatherer::Merge(TMany<Event>&& events) {
+   auto& metrics = GetProducer()->GetMetrics().mCurrent;
+   for (auto& e : events) {
+      if (not mEventQueue.FindIt(e.mType))
+         mEventQueue.Insert(e.mType);
+
+      auto& group = mEventQueue[e.mType];
+      const auto state = group.FindIt(e.mState);
+      if (state) {
+         state.GetValue().mPayload += e.mPayload;
+         ++metrics.mCoalesced;
+      }
+      else group.Insert(e.mState, std::move(e));
+   }
 }
 
 /// System update routine                                                     
 ///   @param deltaTime - time between updates                                 
 ///   @param globalEvents - global list of events                             
+///   @param repeats - global list of key auto-repeats                        
 ///   @return false if the system has been terminated by user request         
-bool InputGatherer::Update(Time deltaTime, const EventList& globalEvents) {
-   // React to the gathered inputs                                      
-   for (auto& listener : mListeners) {
-      listener.Update(deltaTime, globalEvents);
-      listener.Update(deltaTime, mEventQueue);
-   }
+bool InputGatherer::Update(
+   Time deltaTime, const EventList& globalEvents, const EventList& repeats
+) {
+   // Pick up events that were ingested since the last update           
+   Consume();
+
+   // React to the gathered inputs, then tick 'hold' events once        
+   Propagate(globalEvents);
+   Propagate(mEventQueue);
+   Propagate(repeats, true);
+   for (auto& listener : mListeners)
+      listener.Update(deltaTime);
 
    // Consume the events                                                
    mEventQueue.Clear();
    return true;
 }
 
+/// Receive events that were routed specifically to this gatherer             
+///   @param events - the events to merge into the gatherer's queue           
+void InputGatherer::Receive(const EventList& events) {
+   for (auto group : events) {
+      for (auto state : group.mValue)
+         PushEvent(state.mValue);
+   }
+}
+
+/// Dispatch events directly to all listeners, without ticking hold events    
+/// Used for late input sampling, see InputSDL::Sample                        
+///   @param events - the events to dispatch                                  
+void InputGatherer::Dispatch(const EventList& events) {
+   Propagate(events);
+}
+
+/// Dispatch events to listeners in order of descending priority, one tier    
+/// of equal priority at a time. Events consumed by a tier are removed for    
+/// the lower tiers, and once all events are consumed, the lower tiers        
+/// aren't visited at all. Consumed End events still release the 'hold'       
+/// anticipators of lower tiers, that were activated before the consumption   
+/// Key auto-repeats go through the same tiers, and can be consumed as well   
+///   @param events - the events to dispatch                                  
+///   @param repeats - whether the events are key auto-repeats                
+void InputGatherer::Propagate(const EventList& events, bool repeats) {
+   if (not events)
+      return;
+
+   auto& metrics = GetProducer()->GetMetrics().mCurrent;
+   const EventList* current = &events;
+   EventList remaining;
+   EventList released;
+   const auto count = mOrder.GetCount();
+   Offset i = 0;
+   while (i < count and (*current or released)) {
+      // Dispatch to a whole tier - they all see the same events        
+      const auto priority = mOrder[i]->GetPriority();
+      while (i < count and mOrder[i]->GetPriority() == priority) {
+         ++metrics.mListeners;
+         if (repeats)
+            mOrder[i]->Repeat(*current);
+         else
+            mOrder[i]->Dispatch(*current);
+         if (released)
+            mOrder[i]->Release(released);
+         ++i;
+      }
+
+      if (not mConsumed)
+         continue;
+
+      // Strip the consumed events for the lower tiers, but keep their  
+      // End states, so that holds below never outlive their keys       
+      EventList next;
+      for (auto group : *current) {
+         bool consumed = false;
+         for (auto type : mConsumed)
+            consumed |= type == group.mKey;
+
+         if (not consumed) {
+            next.Insert(group.mKey, group.mValue);
+            continue;
+         }
+
+         const auto end = group.mValue.FindIt(EventState::End);
+         if (end) {
+            released.Insert(group.mKey);
+            released[group.mKey].Insert(EventState::End, end.GetValue());
+         }
+      }
+
+      mConsumed.Clear();
+      remaining = std::move(next);
+      current = &remaining;
+   }
+
+   mConsumed.Clear();
+}
+
+/// Register a listener, keeping listeners sorted by descending priority      
+/// Listeners of equal priority are kept in order of registration             
+///   @param listener - the listener to register                              
+void InputGatherer::Register(InputListener* listener) {
+   mOrder << listener;
+   const auto priority = listener->GetPriority();
+   for (auto i = mOrder.GetCount() - 1; i > 0; --i) {
+      if (mOrder[i - 1]->GetPriority() >= priority)
+         break;
+      std::swap(mOrder[i - 1], mOrder[i]);
+   }
+}
+
+/// Unregister a listener, preserving the order of the rest                   
+///   @param listener - the listener to unregister                            
+void InputGatherer::Unregister(InputListener* listener) {
+   for (Offset i = 0; i < mOrder.GetCount(); ++i) {
+      if (mOrder[i] == listener) {
+         mOrder.RemoveIndex(i);
+         return;
+      }
+   }
+}
+
+/// Consume an event type, so that listeners of lower priority than the       
+/// currently dispatched tier won't see it in this dispatch                   
+///   @param type - the event type to consume                                 
+void InputGatherer::StopPropagation(DMeta type) {
+   for (auto consumed : mConsumed) {
+      if (consumed == type)
+         return;
+   }
+   mConsumed << type;
+}
+
+/// Dispatch key auto-repeats directly to all listeners, by priority          
+/// Used for routed repeats and late input sampling, see InputSDL             
+///   @param repeats - the repeated keys                                      
+void InputGatherer::Repeat(const EventList& repeats) {
+   Propagate(repeats, true);
+}
+
+/// Check if the gatherer has anything to do on the next update               
+///   @return true if there are queued events or active hold anticipators     
+bool InputGatherer::HasPendingWork() const {
+   if (mEventQueue or mIngested.load(std::memory_order_relaxed))
+      return true;
+
+   for (auto& listener : mListeners) {
+      if (listener.IsActive())
+         return true;
+   }
+   return false;
+}
+
+/// Replace the action map - anticipators bound to actions will pick up the   
+/// new bindings on their next interaction, without being recreated           
+///   @param map - the new action map                                         
+void InputGatherer::SetActionMap(ActionMap&& map) {
+   // Subscribe to the new events before unsubscribing from the old     
+   // ones, so that categories in both maps aren't toggled needlessly   
+   Subscribe(map, true);
+   Subscribe(mActionMap, false);
+   mActionMap = std::move(map);
+   ++mActionGeneration;
+   VERBOSE_INPUT("Action map replaced");
+}
+
+/// Get the current action map                                                
+///   @return the action map                                                  
+const ActionMap& InputGatherer::GetActionMap() const noexcept {
+   return mActionMap;
+}
+
+/// Get the generation of the action map, incremented on each replacement     
+///   @return the generation                                                  
+Count InputGatherer::GetActionGeneration() const noexcept {
+   return mActionGeneration;
+}
+
+/// Subscribe to, or unsubscribe from all events in an action map             
+///   @param map - the action map                                             
+///   @param subscribe - whether to subscribe or unsubscribe                  
+void InputGatherer::Subscribe(const ActionMap& map, bool subscribe) {
+   auto module = GetProducer();
+   for (auto action : map.GetActions()) {
+      for (auto type : action.mValue) {
+         if (subscribe)
+            module->Subscribe(type);
+         else
+            module->Unsubscribe(type);
+      }
+   }
+}
+
+/// Bind an event type to an action                                           
+///   @param action - the name of the action                                  
+///   @param type - the event type that triggers the action                   
+void ActionMap::Bind(const Text& action, DMeta type) {
+   const auto found = mActions.FindIt(action);
+   if (found)
+      found.GetValue() << type;
+   else
+      mActions.Insert(action, TMany<DMeta> {type});
+}
+
+/// Remove all bindings of an action                                          
+///   @param action - the name of the action                                  
+void ActionMap::Unbind(const Text& action) {
+   mActions.RemoveKey(action);
+}
+
+/// Find the event types an action is bound to                                
+///   @param action - the name of the action                                  
+///   @return the bound event types, or nullptr if action isn't bound         
+const TMany<DMeta>* ActionMap::Find(const Text& action) const {
+   const auto found = mActions.FindIt(action);
+   return found ? &found.GetValue() : nullptr;
+}
+
+/// Get all actions and their bindings                                        
+///   @return the actions                                                     
+const TUnorderedMap<Text, TMany<DMeta>>& ActionMap::GetActions() const noexcept {
+   return mActions;
+}
+
 /// React on environmental change                                             
 void InputGatherer::Refresh() {
 
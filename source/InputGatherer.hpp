@@ -7,10 +7,82 @@
 ///                                                                           
 #pragma once
 #include "InputListener.hpp"
+#include "Evdev.hpp"
 #include <Langulus/Flow/Factory.hpp>
 #include <Langulus/Flow/Producible.hpp>
 #include <Langulus/Verbs/Create.hpp>
 #include <Langulus/Verbs/Interact.hpp>
+#include <atomic>
+#include <memory>
+
+
+///                                                                           
+///   SDL window identifier                                                   
+///                                                                           
+/// Put it in an input gatherer's descriptor to bind the gatherer to a        
+/// window - all events that occur in it will be delivered only to that       
+/// gatherer, instead of being broadcasted to all gatherers. The identifier   
+/// is the one SDL_GetWindowID reports for a window created through the same  
+/// SDL library this module uses, like the windows of an SDL window module    
+/// in the same process. Any other identifier is accepted, but SDL never      
+/// reports events for it, so the gatherer only receives broadcasts           
+///                                                                           
+struct InputWindow {
+   LANGULUS(POD) true;
+   LANGULUS(NULLIFIABLE) true;
+
+   SDL_WindowID mID {};
+};
+
+
+///                                                                           
+///   Linux input device                                                      
+///                                                                           
+/// Put it in an input gatherer's descriptor to read input directly from an   
+/// evdev device, like /dev/input/event3, bypassing SDL and the desktop.      
+/// Any stream of input_event records works - a pipe or a recorded stream     
+/// can stand in for a real device. If the gatherer has no devices and SDL    
+/// fails to create its input window, all devices in /dev/input are used      
+///                                                                           
+struct InputDevice {
+   Text mPath;
+};
+
+
+///                                                                           
+///   Idle mode request                                                       
+///                                                                           
+/// Put it in the input module's descriptor, or in an input gatherer's        
+/// descriptor, to make the module's Update block while there's no pending    
+/// work, until input arrives or the timeout expires. Idle mode is module     
+/// wide - the latest request wins, and a zero timeout disables it again      
+///                                                                           
+struct InputIdle {
+   LANGULUS(POD) true;
+   LANGULUS(NULLIFIABLE) true;
+
+   Time mTimeout {};
+};
+
+
+///                                                                           
+///   Action map                                                              
+///                                                                           
+/// Maps named actions to the physical events that trigger them. Anticipators 
+/// bound to an action resolve it through their gatherer's action map, so     
+/// rebinding controls is a single map replacement - no anticipator has to be 
+/// recreated, and no script has to be parsed again                           
+///                                                                           
+struct ActionMap {
+private:
+   TUnorderedMap<Text, TMany<DMeta>> mActions;
+
+public:
+   void Bind(const Text&, DMeta);
+   void Unbind(const Text&);
+   const TMany<DMeta>* Find(const Text&) const;
+   const TUnorderedMap<Text, TMany<DMeta>>& GetActions() const noexcept;
+};
 
 
 ///                                                                           
@@ -27,12 +99,51 @@ struct InputGatherer final : A::InputGatherer, ProducedFrom<InputSDL> {
    LANGULUS_VERBS(Verbs::Create, Verbs::Interact);
 
 private:
+   // Listeners, sorted by descending priority. Declared before         
+   // mListeners, so that it outlives them on destruction               
+   TMany<InputListener*> mOrder;
+   // Event types consumed by the currently dispatched tier of listeners
+   TMany<DMeta> mConsumed;
+
    // List of created input listeners                                   
    TFactory<InputListener> mListeners;
 
    // Mouse and keyboard inputs always require a window in order to     
-   // work relatively. This window will be a small borderless one.      
+   // work relatively. This window will be a small borderless one, made 
+   // only if the gatherer is given no windows or devices to read       
    SDL_Window* mInputFocus {};
+   // Whether the video subsystem was acquired for the input window     
+   bool mVideo = false;
+
+   // Windows owned by this gatherer - events from these are routed     
+   // only to this gatherer                                             
+   TMany<SDL_WindowID> mWindows;
+   // Devices this gatherer reads directly, shared with the module      
+   TMany<Ref<EvdevDevice>> mDevices;
+
+   // A batch of events, ingested as a whole - batches are owned by the 
+   // stack below while in it, and by a std::unique_ptr otherwise       
+   struct Batch {
+      TMany<Event> mEvents;
+      Batch* mNext {};
+   };
+
+   // Lock-free stack of ingested batches, that any thread can push to  
+   // and that is swapped out as a whole at the start of each Update    
+   std::atomic<Batch*> mIngested {};
+
+   // Maps named actions to events, for anticipators bound to actions   
+   ActionMap mActionMap;
+   // Incremented each time the action map is replaced                  
+   Count mActionGeneration = 1;
+   // Set once detached from the module, see Detach()                   
+   bool mDetached = false;
+
+   void Consume();
+   void Merge(TMany<Event>&&);
+   void Subscribe(const ActionMap&, bool);
+   void Propagate(const EventList&, bool = false);
+   void Detach();
 
 public:
     InputGatherer(InputSDL*, const Many&);
@@ -41,7 +152,20 @@ public:
    void Create(Verb&);
    void Interact(Verb&);
 
-   bool Update(Time, const EventList&);
+   bool Update(Time, const EventList&, const EventList&);
+   void Receive(const EventList&);
+   void Dispatch(const EventList&);
+   void Repeat(const EventList&);
+   bool HasPendingWork() const;
+   void Ingest(TMany<Event>&&);
+
+   void Register(InputListener*);
+   void Unregister(InputListener*);
+   void StopPropagation(DMeta);
+
+   void SetActionMap(ActionMap&&);
+   const ActionMap& GetActionMap() const noexcept;
+   Count GetActionGeneration() const noexcept;
    void Refresh();
    void Teardown();
 };
\ No newline at end of file
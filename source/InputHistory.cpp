@@ -0,0 +1,349 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "InputHistory.hpp"
+#include <cstring>
+
+
+/// Write an unsigned varint                                                  
+///   @param value - the value to write                                       
+///   @param out - where to write it                                          
+static void WriteVarint(uint32_t value, TMany<uint8_t>& out) {
+   while (value >= 0x80) {
+      out << static_cast<uint8_t>(value | 0x80);
+      value >>= 7;
+   }
+   out << static_cast<uint8_t>(value);
+}
+
+/// Read an unsigned varint                                                   
+///   @param in - where to read from                                          
+///   @param offset - where to start reading, will be moved past the varint   
+///   @return the read value                                                  
+static uint32_t ReadVarint(const TMany<uint8_t>& in, Offset& offset) {
+   uint32_t value = 0;
+   for (int shift = 0; offset < in.GetCount(); shift += 7) {
+      const auto byte = in[offset++];
+      value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if (not (byte & 0x80))
+         break;
+   }
+   return value;
+}
+
+/// Write the raw bits of a vector                                            
+///   @param value - the vector to write                                      
+///   @param out - where to write it                                          
+static void WriteVector(const Math::Vec2f& value, TMany<uint8_t>& out) {
+   uint8_t raw[2 * sizeof(float)];
+   std::memcpy(raw, &value.x, sizeof(float));
+   std::memcpy(raw + sizeof(float), &value.y, sizeof(float));
+   for (auto byte : raw)
+      out << byte;
+}
+
+/// Read the raw bits of a vector                                             
+///   @param in - where to read from                                          
+///   @param offset - where to start reading, will be moved past the vector   
+///   @return the read vector                                                 
+static Math::Vec2f ReadVector(const TMany<uint8_t>& in, Offset& offset) {
+   uint8_t raw[2 * sizeof(float)] {};
+   for (auto& byte : raw) {
+      if (offset < in.GetCount())
+         byte = in[offset++];
+   }
+
+   Math::Vec2f value;
+   std::memcpy(&value.x, raw, sizeof(float));
+   std::memcpy(&value.y, raw + sizeof(float), sizeof(float));
+   return value;
+}
+
+/// Apply a key transition to the held keys                                   
+///   @param transition - (index << 1) | released                             
+void InputState::Apply(uint16_t transition) {
+   const uint16_t key = transition >> 1;
+   for (Offset i = 0; i < mHeld.GetCount(); ++i) {
+      if (mHeld[i] != key)
+         continue;
+
+      if (transition & 1)
+         mHeld.RemoveIndex(i);
+      return;
+   }
+
+   if (not (transition & 1))
+      mHeld << key;
+}
+
+/// Check if a key is held                                                    
+///   @param key - the key index                                              
+///   @return true if key is held                                             
+bool InputState::IsHeld(uint16_t key) const noexcept {
+   for (auto held : mHeld) {
+      if (held == key)
+         return true;
+   }
+   return false;
+}
+
+/// Set the number of snapshots to keep, resets the history                   
+///   @param depth - number of frames to keep, zero to disable recording      
+void InputHistory::SetDepth(Count depth) {
+   mDepth = depth;
+   mFrames.Clear();
+   mKeyframes.Clear();
+   for (Count i = 0; i < depth; ++i) {
+      mFrames << TMany<uint8_t> {};
+      mKeyframes << TMany<uint16_t> {};
+   }
+
+   mCount = 0;
+   mHead = 0;
+   mBase = {};
+   mCurrent = {};
+
+   // Transitions aren't followed while history is disabled, so what    
+   // the gatherers were told is stale - start tracking it from scratch 
+   mDelivered = {};
+}
+
+/// Check if history is being recorded                                        
+///   @return true if recording                                               
+bool InputHistory::IsEnabled() const noexcept {
+   return mDepth > 0;
+}
+
+/// Record a key or button transition in the current frame                    
+///   @param e - the event, only Begin and End events are recorded            
+void InputHistory::Record(const Event& e) {
+   if (e.mState != EventState::Begin and e.mState != EventState::End)
+      return;
+
+   uint16_t key;
+   const auto found = mKeyIndices.FindIt(e.mType);
+   if (found)
+      key = found.GetValue();
+   else {
+      key = static_cast<uint16_t>(mKeys.GetCount());
+      mKeys << e.mType;
+      mKeyIndices.Insert(e.mType, key);
+   }
+
+   const uint16_t transition = (key << 1) | (e.mState == EventState::End);
+   mCurrent.mTransitions << transition;
+   mCurrent.Apply(transition);
+   mDelivered.Apply(transition);
+}
+
+/// Record mouse movement in the current frame                                
+///   @param delta - the relative movement                                    
+void InputHistory::RecordMouse(const Math::Vec2f& delta) {
+   mCurrent.mMouse.x += delta.x;
+   mCurrent.mMouse.y += delta.y;
+}
+
+/// Record mouse scroll in the current frame                                  
+///   @param delta - the relative scroll                                      
+void InputHistory::RecordScroll(const Math::Vec2f& delta) {
+   mCurrent.mScroll.x += delta.x;
+   mCurrent.mScroll.y += delta.y;
+}
+
+/// Encode the current frame into the ring, and start a new frame             
+void InputHistory::Commit() {
+   if (not mDepth)
+      return;
+
+   mHead = mCount ? (mHead + 1) % mDepth : 0;
+   if (mCount == mDepth) {
+      // Ring is full - fold the oldest snapshot into the base state    
+      InputState oldest;
+      Decode(mFrames[mHead], oldest);
+      for (auto transition : oldest.mTransitions)
+         mBase.Apply(transition);
+   }
+   else ++mCount;
+
+   auto& snapshot = mFrames[mHead];
+   snapshot.Clear();
+   Encode(mCurrent, snapshot);
+   ++mFrame;
+
+   // Keep the held keys aside on keyframes                             
+   auto& keyframe = mKeyframes[mHead];
+   keyframe.Clear();
+   if (mFrame % KeyframeInterval == 0) {
+      for (auto key : mCurrent.mHeld)
+         keyframe << key;
+   }
+
+   // Held keys carry over to the next frame, everything else resets    
+   mCurrent.mTransitions.Clear();
+   mCurrent.mMouse = {};
+   mCurrent.mScroll = {};
+}
+
+/// Encode the changes of a frame                                             
+///   @param state - the state to encode                                      
+///   @param out - where to write the snapshot                                
+void InputHistory::Encode(const InputState& state, TMany<uint8_t>& out) {
+   uint8_t flags = 0;
+   if (state.mTransitions)
+      flags |= HasTransitions;
+   if (state.mMouse)
+      flags |= HasMouse;
+   if (state.mScroll)
+      flags |= HasScroll;
+
+   out << flags;
+   if (flags & HasTransitions) {
+      WriteVarint(static_cast<uint32_t>(state.mTransitions.GetCount()), out);
+      for (auto transition : state.mTransitions)
+         WriteVarint(transition, out);
+   }
+
+   if (flags & HasMouse)
+      WriteVector(state.mMouse, out);
+   if (flags & HasScroll)
+      WriteVector(state.mScroll, out);
+}
+
+/// Decode the changes of a frame                                             
+/// Held keys are not touched - apply the transitions to get them             
+///   @param in - the snapshot                                                
+///   @param state - [out] where to decode the changes                        
+void InputHistory::Decode(const TMany<uint8_t>& in, InputState& state) {
+   state.mTransitions.Clear();
+   state.mMouse = {};
+   state.mScroll = {};
+   if (not in)
+      return;
+
+   Offset offset = 0;
+   const auto flags = in[offset++];
+   if (flags & HasTransitions) {
+      const auto count = ReadVarint(in, offset);
+      for (uint32_t i = 0; i < count; ++i)
+         state.mTransitions << static_cast<uint16_t>(ReadVarint(in, offset));
+   }
+
+   if (flags & HasMouse)
+      state.mMouse = ReadVector(in, offset);
+   if (flags & HasScroll)
+      state.mScroll = ReadVector(in, offset);
+}
+
+/// Get the absolute number of the newest recorded frame                      
+///   @return the frame number, starting from one                             
+uint64_t InputHistory::GetFrame() const noexcept {
+   return mFrame;
+}
+
+/// Get the number of frames in the ring                                      
+///   @return the number of frames that can be fetched                        
+Count InputHistory::GetCount() const noexcept {
+   return mCount;
+}
+
+/// Get the encoded snapshot of a frame                                       
+///   @param frame - the absolute frame number                                
+///   @return the snapshot, or nullptr if frame is no longer in history       
+const TMany<uint8_t>* InputHistory::GetSnapshot(uint64_t frame) const noexcept {
+   if (not mCount or frame > mFrame or mFrame - frame >= mCount)
+      return nullptr;
+
+   return &mFrames[GetSlot(frame)];
+}
+
+/// Get the index of a frame in the ring                                      
+///   @param frame - the absolute frame number, must be in history            
+///   @return the index in the ring                                           
+Offset InputHistory::GetSlot(uint64_t frame) const noexcept {
+   const auto back = static_cast<Offset>(mFrame - frame);
+   return (mHead + mDepth - back) % mDepth;
+}
+
+/// Reconstruct the full input state of a frame, by applying the snapshots    
+/// since the closest keyframe, or since the oldest snapshot in the ring if   
+/// the keyframe is no longer in history - either way at most                 
+/// KeyframeInterval snapshots are decoded                                    
+///   @param frame - the absolute frame number                                
+///   @param state - [out] the reconstructed state                            
+///   @return true if frame is still in history                               
+bool InputHistory::GetState(uint64_t frame, InputState& state) const {
+   if (not GetSnapshot(frame))
+      return false;
+
+   const auto oldest = mFrame - mCount + 1;
+   const auto keyframe = frame - frame % KeyframeInterval;
+   auto from = oldest;
+   state.mHeld.Clear();
+   if (keyframe and keyframe >= oldest) {
+      for (auto key : mKeyframes[GetSlot(keyframe)])
+         state.mHeld << key;
+      from = keyframe + 1;
+   }
+   else {
+      for (auto key : mBase.mHeld)
+         state.mHeld << key;
+   }
+
+   for (auto f = from; f <= frame; ++f) {
+      Decode(*GetSnapshot(f), state);
+      for (auto transition : state.mTransitions)
+         state.Apply(transition);
+   }
+
+   // The keyframe itself was requested - its held keys are already in, 
+   // but its changes still need decoding                               
+   if (from > frame)
+      Decode(*GetSnapshot(frame), state);
+   return true;
+}
+
+/// Get the transitions, that drive the gatherers through a historical frame  
+/// First come the transitions that restore the keys held when the frame      
+/// began, starting from the keys the gatherers were last told about, and     
+/// then the transitions of the frame itself                                  
+///   @param state - the reconstructed state of the frame, see GetState       
+///   @return the transitions to push, each is (index << 1) | released        
+TMany<uint16_t> InputHistory::Replay(const InputState& state) {
+   // Undo the transitions of the frame, to get the keys held before it 
+   InputState before;
+   for (auto key : state.mHeld)
+      before.mHeld << key;
+   for (auto i = state.mTransitions.GetCount(); i > 0; --i)
+      before.Apply(state.mTransitions[i - 1] ^ 1);
+
+   TMany<uint16_t> transitions;
+   for (auto key : mDelivered.mHeld) {
+      if (not before.IsHeld(key))
+         transitions << static_cast<uint16_t>((key << 1) | 1);
+   }
+   for (auto key : before.mHeld) {
+      if (not mDelivered.IsHeld(key))
+         transitions << static_cast<uint16_t>(key << 1);
+   }
+   for (auto transition : state.mTransitions)
+      transitions << transition;
+
+   // Gatherers now hold what the frame ended with                      
+   mDelivered.mHeld.Clear();
+   for (auto key : state.mHeld)
+      mDelivered.mHeld << key;
+   return transitions;
+}
+
+/// Get the type of a key from its dictionary index                           
+///   @param index - the key index, as found in InputState                    
+///   @return the key type, or nullptr if index is not in dictionary          
+DMeta InputHistory::GetKey(uint16_t index) const noexcept {
+   if (index >= mKeys.GetCount())
+      return {};
+   return mKeys[index];
+}
\ No newline at end of file
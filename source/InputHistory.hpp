@@ -0,0 +1,109 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+
+///                                                                           
+///   Input state at the end of a frame                                       
+///                                                                           
+struct InputState {
+   // Held keys and buttons, as indices in the history's dictionary     
+   TMany<uint16_t> mHeld;
+   // Key/button transitions during the frame, in chronological order   
+   // Each entry is (index << 1) | released                             
+   TMany<uint16_t> mTransitions;
+   // Accumulated mouse movement and scroll during the frame            
+   Math::Vec2f mMouse;
+   Math::Vec2f mScroll;
+
+   void Apply(uint16_t);
+   bool IsHeld(uint16_t) const noexcept;
+};
+
+
+///                                                                           
+///   Input history                                                           
+///                                                                           
+/// Records a compact snapshot of the input state for each frame, encoded as  
+/// a delta against the previous frame, and keeps the last N of them in a     
+/// ring buffer, for rollback and deterministic lockstep simulation.          
+///                                                                           
+/// Each snapshot starts with a flag byte, followed by the key transitions    
+/// as varints, and the raw bits of mouse movement and scroll if non-zero.    
+/// An idle frame is encoded as a single zero byte. Keys are encoded as       
+/// indices in a dictionary that is local to the process, so snapshots are    
+/// meant for re-simulation and not for persistent storage.                   
+///                                                                           
+/// Held keys aren't part of the snapshots. They are kept aside for every     
+/// keyframe, so that reconstructing the state of any frame decodes at most   
+/// KeyframeInterval snapshots, regardless of the depth of the ring.          
+///                                                                           
+/// Analog axes aren't recorded, because the module doesn't produce any yet - 
+/// gamepad axes aren't translated, and the absolute axes of devices read     
+/// directly arrive as mouse movement, which is recorded. Gamepad motion      
+/// sensors are out of scope, too - their batches are too large for a         
+/// snapshot, and they aren't meant to be replayed                            
+///                                                                           
+struct InputHistory {
+   enum Flags : uint8_t {
+      HasTransitions = 1,
+      HasMouse = 2,
+      HasScroll = 4
+   };
+
+   // Held keys are kept for every frame, whose number is a multiple    
+   static constexpr Count KeyframeInterval = 16;
+
+private:
+   // Maximum number of snapshots in the ring, zero if disabled         
+   Count mDepth = 0;
+   // Ring of encoded snapshots                                         
+   TMany<TMany<uint8_t>> mFrames;
+   // Held keys at the end of each snapshot, only filled for keyframes  
+   TMany<TMany<uint16_t>> mKeyframes;
+   // Number of snapshots in the ring                                   
+   Count mCount = 0;
+   // Index of the newest snapshot in the ring                          
+   Offset mHead = 0;
+   // Absolute number of the newest frame                               
+   uint64_t mFrame = 0;
+
+   // Dictionary of key and button types                                
+   TMany<DMeta> mKeys;
+   TUnorderedMap<DMeta, uint16_t> mKeyIndices;
+
+   // State before the oldest snapshot in the ring                      
+   InputState mBase;
+   // State of the frame that is currently being recorded               
+   InputState mCurrent;
+   // Keys that gatherers were last told are held - follows both the    
+   // recorded and the re-injected transitions                          
+   InputState mDelivered;
+
+   Offset GetSlot(uint64_t) const noexcept;
+
+public:
+   static void Encode(const InputState&, TMany<uint8_t>&);
+   static void Decode(const TMany<uint8_t>&, InputState&);
+
+   void SetDepth(Count);
+   bool IsEnabled() const noexcept;
+
+   void Record(const Event&);
+   void RecordMouse(const Math::Vec2f&);
+   void RecordScroll(const Math::Vec2f&);
+   void Commit();
+
+   uint64_t GetFrame() const noexcept;
+   Count GetCount() const noexcept;
+   const TMany<uint8_t>* GetSnapshot(uint64_t) const noexcept;
+   bool GetState(uint64_t, InputState&) const;
+   TMany<uint16_t> Replay(const InputState&);
+   DMeta GetKey(uint16_t) const noexcept;
+};
\ No newline at end of file
@@ -9,6 +9,21 @@
 #include "InputSDL.hpp"
 
 
+/// Keeps the hot arrays in place while anticipators are being dispatched,    
+/// and applies the registrations made by their scripts once it's over        
+struct InputListener::Dispatching {
+   InputListener* mListener;
+
+   Dispatching(InputListener* listener) : mListener {listener} {
+      ++mListener->mDispatching;
+   }
+
+   ~Dispatching() {
+      if (--mListener->mDispatching == 0)
+         mListener->Flush();
+   }
+};
+
 /// Listener construction                                                     
 ///   @param producer - the producer                                          
 ///   @param descriptor - instructions for configuring the listener           
@@ -16,15 +31,43 @@ InputListener::InputListener(InputGatherer* producer, const Many& descriptor)
    : Resolvable    {this}
    , ProducedFrom  {producer, descriptor} {
    VERBOSE_INPUT("Initializing...");
+   descriptor.ExtractData(mPolicy);
    Couple(descriptor);
+   producer->Register(this);
    VERBOSE_INPUT("Initialized");
 }
 
-/// First stage destruction                                                   
+/// Listener destruction                                                      
+InputListener::~InputListener() {
+   Detach();
+}
+
+/// First stage destruction - detach while the gatherer and module are still  
+/// reachable, since they might be gone by the time destructors run           
 void InputListener::Teardown() {
+   Detach();
    mAnticipators.Teardown();
 }
 
+/// Detach the listener and its anticipators from the gatherer and module     
+/// Does nothing if already detached, or if the gatherer is gone              
+void InputListener::Detach() {
+   const auto gatherer = GetProducer();
+   if (mDetached or not gatherer)
+      return;
+
+   // Each anticipator removes itself from the end of the hot arrays    
+   for (auto i = mPending.GetCount(); i > 0; --i)
+      mPending[i - 1]->Detach();
+   for (auto i = mCold.GetCount(); i > 0; --i) {
+      if (mCold[i - 1])
+         mCold[i - 1]->Detach();
+   }
+
+   gatherer->Unregister(this);
+   mDetached = true;
+}
+
 /// React on environmental change                                             
 void InputListener::Refresh() {
 
@@ -36,21 +79,254 @@ void InputListener::Create(Verb& verb) {
    mAnticipators.Create(this, verb);
 }
 
-/// React on events                                                           
+/// Get the bit of an event state, used in the hot state masks                
+///   @param state - the event state                                          
+///   @return the bit                                                         
+static uint8_t StateBit(const EventState& state) noexcept {
+   if (state == EventState::Point)
+      return 1;
+   if (state == EventState::Begin)
+      return 2;
+   if (state == EventState::End)
+      return 4;
+   return 8;
+}
+
+/// Get the mask of event states an anticipator may react on                  
+///   @param state - the anticipated event state                              
+///   @return the mask                                                        
+static uint8_t StateMask(const EventState& state) noexcept {
+   if (state == EventState::Point)
+      return StateBit(EventState::Point) | StateBit(EventState::Begin);
+   if (state == EventState::Begin or state == EventState::End)
+      return StateBit(state);
+
+   // Hold events activate on Begin and deactivate on End               
+   return StateBit(EventState::Begin) | StateBit(EventState::End);
+}
+
+/// Tick all active 'hold' anticipators, once per update                      
 ///   @param deltaTime - time between Update calls                            
+void InputListener::Update(const Time& deltaTime) {
+   // Execute all active anticipators' scripts - these are essentially  
+   // 'hold' events and need to be updated each tick, or throttled      
+   // triggers that wait for their window to expire                     
+   Dispatching scope {this};
+   const auto count = mCold.GetCount();
+   const auto active = mHotActive.GetRaw();
+   for (Offset i = 0; i < count; ++i) {
+      if (not active[i] or not mCold[i])
+         continue;
+
+      // Anticipators removed by the script are already accounted for   
+      if (mCold[i]->Tick(deltaTime) or not mCold[i])
+         continue;
+
+      active[i] = 0;
+      --mActiveCount;
+   }
+}
+
+/// React on events, without ticking hold events                              
+/// Hold anticipators can still be activated/deactivated, their scripts will  
+/// be executed on the next Update                                            
 ///   @param events - events to react to                                      
-void InputListener::Update(const Time& deltaTime, const EventList& events) {
-   // Execute all active anticipators' scripts                          
-   for (auto& ant : mAnticipators) {
-      if (not ant.Interact(events))
+void InputListener::Dispatch(const EventList& events) {
+   Match(events);
+}
+
+/// React on key auto-repeats - only anticipators that opted in via their     
+/// policy are triggered                                                      
+///   @param repeats - the repeated keys, as Point events                     
+void InputListener::Repeat(const EventList& repeats) {
+   Dispatching scope {this};
+   const auto count = mCold.GetCount();
+   const auto types = mHotTypes.GetRaw();
+   const auto active = mHotActive.GetRaw();
+   for (Offset i = 0; i < count; ++i) {
+      // Anticipators bound to actions resolve the repeated keys first  
+      if (not mCold[i]
+      or  (not mCold[i]->mPolicy.mRepeat and not mCold[i]->mPolicy.mConsume)
+      or  (types[i] and not repeats.FindIt(types[i])))
+         continue;
+
+      mCold[i]->Repeat(repeats);
+
+      // A throttled repeat is executed from Update, when it's due      
+      if (mCold[i] and mCold[i]->mDeferred and not active[i]) {
+         active[i] = 1;
+         ++mActiveCount;
+      }
+   }
+}
+
+/// Release active 'hold' anticipators on End events, that were consumed by   
+/// listeners of higher priority - a hold must never outlive its key, even if 
+/// a listener above started consuming the key while it was held              
+///   @param ends - the consumed End events                                   
+void InputListener::Release(const EventList& ends) {
+   if (not mActiveCount)
+      return;
+
+   Dispatching scope {this};
+   const auto count = mCold.GetCount();
+   const auto active = mHotActive.GetRaw();
+   for (Offset i = 0; i < count; ++i) {
+      if (not active[i] or not mCold[i] or mCold[i]->Release(ends))
+         continue;
+
+      active[i] = 0;
+      --mActiveCount;
+   }
+}
+
+/// Find the anticipators that may react on the events, by comparing event    
+/// types and states against the hot arrays, and let only them interact       
+///   @param events - events to react to                                      
+void InputListener::Match(const EventList& events) {
+   if (not events or not mCold)
+      return;
+
+   const auto count = mCold.GetCount();
+   const auto types = mHotTypes.GetRaw();
+   const auto states = mHotStates.GetRaw();
+   const auto matched = mHotMatched.GetRaw();
+
+   // Anticipators bound to actions can match any event type            
+   for (Offset i = 0; i < count; ++i)
+      matched[i] = not types[i];
+
+   for (auto group : events) {
+      uint8_t mask = 0;
+      for (auto state : group.mValue)
+         mask |= StateBit(state.mKey);
+
+      const DMeta type = group.mKey;
+      for (Offset i = 0; i < count; ++i)
+         matched[i] |= (types[i] == type) & ((states[i] & mask) != 0);
+   }
+
+   // Only the matched anticipators touch their cold data               
+   Dispatching scope {this};
+   auto& metrics = GetModule()->GetMetrics().mCurrent;
+   const auto active = mHotActive.GetRaw();
+   for (Offset i = 0; i < count; ++i) {
+      if (not matched[i] or not mCold[i])
          continue;
-      
-      // The anticipator is active and needs to be updated each         
-      // tick. This is essentially a 'hold' event                       
-      VERBOSE_INPUT("Hold event triggered: ", ant.mEvent);
-      Many unusedSideEffects;
-      ant.mFlow.Update(deltaTime, unusedSideEffects);
+
+      ++metrics.mAnticipators;
+      const uint8_t isActive = mCold[i]->Interact(events);
+
+      // Anticipators removed by the script are already accounted for   
+      if (not mCold[i])
+         continue;
+
+      mActiveCount += isActive;
+      mActiveCount -= active[i];
+      active[i] = isActive;
+   }
+}
+
+/// Check if any 'hold' anticipators are active, and need to be ticked        
+///   @return true if listener has work to do on each update                  
+bool InputListener::IsActive() const noexcept {
+   return mActiveCount > 0;
+}
+
+/// Get the priority of the listener - higher priority listeners react on     
+/// events first, and may consume them                                        
+///   @return the priority                                                    
+int InputListener::GetPriority() const noexcept {
+   return mPolicy.mPriority;
+}
+
+/// Register an anticipator in the hot arrays - anticipators created by       
+/// scripts during a dispatch are registered once it's over                   
+///   @param ant - the anticipator to register                                
+void InputListener::Register(Anticipator* ant) {
+   if (mDispatching)
+      mPending << ant;
+   else
+      Append(ant);
+}
+
+/// Append an anticipator to the hot arrays                                   
+///   @param ant - the anticipator to append                                  
+void InputListener::Append(Anticipator* ant) {
+   ant->mSlot = mCold.GetCount();
+   mHotTypes << ant->mEvent.mType;
+   mHotStates << StateMask(ant->mEvent.mState);
+   mHotActive << uint8_t {0};
+   mHotMatched << uint8_t {0};
+   mCold << ant;
+}
+
+/// Remove an anticipator from the hot arrays - anticipators destroyed by     
+/// scripts during a dispatch only vacate their slot, until it's over         
+///   @param ant - the anticipator to unregister                              
+void InputListener::Unregister(Anticipator* ant) {
+   for (Offset i = 0; i < mPending.GetCount(); ++i) {
+      if (mPending[i] == ant) {
+         mPending.RemoveIndex(i);
+         return;
+      }
+   }
+
+   const auto slot = ant->mSlot;
+   mActiveCount -= mHotActive[slot];
+   if (mDispatching) {
+      mHotTypes[slot] = {};
+      mHotStates[slot] = 0;
+      mHotActive[slot] = 0;
+      mCold[slot] = nullptr;
+      mVacated = true;
+      return;
+   }
+
+   Remove(slot);
+}
+
+/// Remove a slot from the hot arrays, by moving the last one in its place    
+///   @param slot - the slot to remove                                        
+void InputListener::Remove(Offset slot) {
+   const auto last = mCold.GetCount() - 1;
+   if (slot != last) {
+      mHotTypes[slot] = mHotTypes[last];
+      mHotStates[slot] = mHotStates[last];
+      mHotActive[slot] = mHotActive[last];
+      mCold[slot] = mCold[last];
+      if (mCold[slot])
+         mCold[slot]->mSlot = slot;
    }
+
+   mHotTypes.RemoveIndex(last);
+   mHotStates.RemoveIndex(last);
+   mHotActive.RemoveIndex(last);
+   mHotMatched.RemoveIndex(last);
+   mCold.RemoveIndex(last);
+}
+
+/// Apply the registrations made during a dispatch - vacated slots are        
+/// removed from the back, so that only live anticipators are moved           
+void InputListener::Flush() {
+   if (mVacated) {
+      for (auto i = mCold.GetCount(); i > 0; --i) {
+         if (not mCold[i - 1])
+            Remove(i - 1);
+      }
+      mVacated = false;
+   }
+
+   for (auto ant : mPending)
+      Append(ant);
+   mPending.Clear();
+}
+
+/// Get the module that (indirectly) produced this listener                   
+///   @return the input module                                                
+InputSDL* InputListener::GetModule() const noexcept {
+   const auto gatherer = GetProducer();
+   return gatherer ? gatherer->GetProducer() : nullptr;
 }
 
 /// Automatically create anticipators by analyzing owner's abilities,         
@@ -65,15 +341,28 @@ void InputListener::AutoBind() {
 ///   @param desc - descriptor                                                
 Anticipator::Anticipator(InputListener* producer, const Many& desc)
    : ProducedFrom {producer, desc} {
-   // What event are we anticipating?                                   
-   LANGULUS_ASSERT(
-         desc.ExtractData(mEvent)
-      or desc.ExtractData(mEvent.mType),
-      Construct, "Invalid event for anticipator from: ", desc);
+   // What are we anticipating? Either a named action, that is mapped   
+   // to events by the gatherer, or a concrete event                    
+   if (not desc.ExtractTrait<Traits::Name>(mAction)) {
+      LANGULUS_ASSERT(
+            desc.ExtractData(mEvent)
+         or desc.ExtractData(mEvent.mType),
+         Construct, "Invalid event for anticipator from: ", desc);
+   }
 
    // Optional state override                                           
    desc.ExtractData(mEvent.mState);
 
+   // Optional trigger policy - limits are converted once, so that they 
+   // are checked cheaply before any flow work on each trigger          
+   if (desc.ExtractData(mPolicy)) {
+      using namespace std::chrono;
+      mThrottle = duration_cast<nanoseconds>(mPolicy.mThrottle).count();
+      mDebounce = duration_cast<nanoseconds>(mPolicy.mDebounce).count();
+      mCooldown = duration_cast<nanoseconds>(mPolicy.mCooldown).count();
+      mGated = mThrottle or mDebounce or mCooldown;
+   }
+
    // How do we react on trigger?                                       
    LANGULUS_ASSERT(desc.ExtractData(mScript),
       Construct, "Missing script for anticipator from: ", desc);
@@ -86,17 +375,90 @@ Anticipator::Anticipator(InputListener* producer, const Many& desc)
    #if VERBOSE_INPUT_ENABLED()
       mFlow.Dump();
    #endif
+
+   // Make sure SDL delivers the events we're anticipating - events     
+   // mapped to actions are subscribed to by the gatherer instead       
+   producer->GetModule()->Subscribe(mEvent.mType);
+   if (mPolicy.mRepeat)
+      producer->GetModule()->SubscribeRepeats();
+   producer->Register(this);
+}
+
+/// Anticipator destruction                                                   
+Anticipator::~Anticipator() {
+   Detach();
+}
+
+/// Unregister from the listener and release the subscriptions in the module  
+/// Called by the listener on teardown, or on destruction, if the anticipator 
+/// is removed on its own. Does nothing if the listener or module is gone     
+void Anticipator::Detach() {
+   const auto listener = GetProducer();
+   if (mDetached or not listener)
+      return;
+
+   mDetached = true;
+   listener->Unregister(this);
+
+   const auto module = listener->GetModule();
+   if (not module)
+      return;
+
+   module->Unsubscribe(mEvent.mType);
+   if (mPolicy.mRepeat)
+      module->UnsubscribeRepeats();
 }
 
 /// Interact with the anticipator                                             
 ///   @param events - the events                                              
-///   @return true if the anticipator is a 'hold' event and needs to be       
-///      handled in the Update() routine instead                              
+///   @return true if the anticipator is an active 'hold' event, or has a     
+///      deferred trigger, and needs to be handled in the Update() routine    
 bool Anticipator::Interact(const EventList& events) {
-   Many unusedSideEffects;
-   auto foundEvent = events.FindIt(mEvent.mType);
+   if (not mAction) {
+      Match(events, mEvent.mType);
+      return mActive or mDeferred;
+   }
+
+   Resolve();
+   if (mActionEvents) {
+      for (auto type : *mActionEvents)
+         Match(events, type);
+   }
+   return mActive or mDeferred;
+}
+
+/// Resolve the action again, only if the gatherer's bindings changed         
+/// An active 'hold' is released, if the event that activated it is no longer 
+/// bound to the action, because it would never see that event's End          
+void Anticipator::Resolve() {
+   auto gatherer = GetProducer()->GetProducer();
+   if (mActionGeneration == gatherer->GetActionGeneration())
+      return;
+
+   mActionEvents = gatherer->GetActionMap().Find(mAction);
+   mActionGeneration = gatherer->GetActionGeneration();
+   if (not mActive)
+      return;
+
+   if (mActionEvents) {
+      for (auto type : *mActionEvents) {
+         if (type == mTrigger)
+            return;
+      }
+   }
+
+   mActive = false;
+   if (mCooldown)
+      mNextTrigger = SDL_GetTicksNS() + mCooldown;
+}
+
+/// Match the anticipator against a type of events                            
+///   @param events - the events                                              
+///   @param type - the type of events to match                               
+void Anticipator::Match(const EventList& events, DMeta type) {
+   auto foundEvent = events.FindIt(type);
    if (not foundEvent)
-      return false;
+      return;
 
    if (mEvent.mState == EventState::Point) {
       // Anticipator doesn't activate - its script will just be         
@@ -104,10 +466,17 @@ bool Anticipator::Interact(const EventList& events) {
       const auto foundState1 = foundEvent.GetValue().FindIt(EventState::Point);
       const auto foundState2 = foundEvent.GetValue().FindIt(EventState::Begin);
       if (foundState1 or foundState2) {
+         const auto verdict = Permit(type, true);
+         if (verdict == Verdict::Denied)
+            return;
+
          if (foundState1)
-            mEvent = foundState1.GetValue();
+            Accept(foundState1.GetValue());
          if (foundState2 and mEvent.mTimestamp < foundState2.GetValue().mTimestamp)
-            mEvent = foundState2.GetValue();
+            Accept(foundState2.GetValue());
+         Claim(type);
+         if (verdict == Verdict::Deferred)
+            return;
 
          VERBOSE_INPUT("Point event triggered: ", mEvent);
          #if VERBOSE_INPUT_ENABLED()
@@ -115,7 +484,7 @@ bool Anticipator::Interact(const EventList& events) {
          #endif
 
          mFlow.Reset();
-         mFlow.Update({}, unusedSideEffects);
+         Execute();
       }
    }
    else if (mEvent.mState == EventState::Begin) {
@@ -123,7 +492,14 @@ bool Anticipator::Interact(const EventList& events) {
       // executed once on a Begin event                                 
       const auto foundState = foundEvent.GetValue().FindIt(EventState::Begin);
       if (foundState) {
-         mEvent = foundState.GetValue();
+         const auto verdict = Permit(type, true);
+         if (verdict == Verdict::Denied)
+            return;
+
+         Accept(foundState.GetValue());
+         Claim(type);
+         if (verdict == Verdict::Deferred)
+            return;
 
          VERBOSE_INPUT("Begin event triggered: ", mEvent);
          #if VERBOSE_INPUT_ENABLED()
@@ -131,7 +507,7 @@ bool Anticipator::Interact(const EventList& events) {
          #endif
 
          mFlow.Reset();
-         mFlow.Update({}, unusedSideEffects);
+         Execute();
       }
    }
    else if (mEvent.mState == EventState::End) {
@@ -139,7 +515,14 @@ bool Anticipator::Interact(const EventList& events) {
       // executed once on an End event                                  
       const auto foundState = foundEvent.GetValue().FindIt(EventState::End);
       if (foundState) {
-         mEvent = foundState.GetValue();
+         const auto verdict = Permit(type, true);
+         if (verdict == Verdict::Denied)
+            return;
+
+         Accept(foundState.GetValue());
+         Claim(type);
+         if (verdict == Verdict::Deferred)
+            return;
 
          VERBOSE_INPUT("End event triggered: ", mEvent);
          #if VERBOSE_INPUT_ENABLED()
@@ -147,7 +530,7 @@ bool Anticipator::Interact(const EventList& events) {
          #endif
 
          mFlow.Reset();
-         mFlow.Update({}, unusedSideEffects);
+         Execute();
       }
    }
    else {
@@ -157,23 +540,264 @@ bool Anticipator::Interact(const EventList& events) {
       if (not mActive) {
          const auto foundState = foundEvent.GetValue().FindIt(EventState::Begin);
          if (foundState) {
-            mEvent = foundState.GetValue();
+            if (Permit(type, false) == Verdict::Denied)
+               return;
+
+            Accept(foundState.GetValue());
+            Claim(type);
             mActive = true;
+            mNextTick = 0;
+            mSkipped = {};
             mFlow.Reset();
          }
       }
       else {
          const auto foundState = foundEvent.GetValue().FindIt(EventState::End);
-         if (foundState)
+         if (foundState) {
+            Claim(type);
             mActive = false;
+            if (mCooldown) {
+               const auto module = GetProducer()->GetModule();
+               mNextTrigger = module->GetOccurrence(type) + mCooldown;
+            }
+         }
+      }
+   }
+}
+
+/// Deactivate an active 'hold' anticipator, if any of the events it reacts   
+/// on has ended - used for End events that were consumed, so they are        
+/// neither claimed, nor do they trigger anything                             
+///   @param ends - the consumed End events                                   
+///   @return true if the anticipator still needs to be ticked                
+bool Anticipator::Release(const EventList& ends) {
+   if (not mActive)
+      return mDeferred;
+
+   DMeta ended;
+   if (not mAction) {
+      if (ends.FindIt(mEvent.mType))
+         ended = mEvent.mType;
+   }
+   else {
+      // The action map might have been replaced since the last trigger 
+      Resolve();
+      if (mActionEvents) {
+         for (auto type : *mActionEvents) {
+            if (ends.FindIt(type))
+               ended = type;
+         }
       }
    }
 
-   return mActive;
+   if (ended) {
+      mActive = false;
+      if (mCooldown) {
+         const auto module = GetProducer()->GetModule();
+         mNextTrigger = module->GetOccurrence(ended) + mCooldown;
+      }
+   }
+   return mActive or mDeferred;
+}
+
+/// React on key auto-repeats, if policy allows it                            
+/// Hold anticipators ignore repeats, since they're ticked anyways            
+/// Anticipators bound to actions react on repeats of any key in the action   
+/// Anticipators that consume their keys consume their repeats, too - even    
+/// if they don't react on them, so that repeats don't leak below them        
+///   @param repeats - the repeated keys, as Point events                     
+void Anticipator::Repeat(const EventList& repeats) {
+   const bool react = mPolicy.mRepeat
+      and (mEvent.mState == EventState::Point
+      or   mEvent.mState == EventState::Begin);
+   if (not react and not mPolicy.mConsume)
+      return;
+
+   if (not mAction) {
+      Repeat(repeats, mEvent.mType, react);
+      return;
+   }
+
+   Resolve();
+   if (mActionEvents) {
+      for (auto type : *mActionEvents)
+         Repeat(repeats, type, react);
+   }
+}
+
+/// React on the repeats of a single key                                      
+///   @param repeats - the repeated keys, as Point events                     
+///   @param type - the key to react on                                       
+///   @param react - whether to react, or only to consume the repeats         
+void Anticipator::Repeat(const EventList& repeats, DMeta type, bool react) {
+   const auto found = repeats.FindIt(type);
+   if (not found)
+      return;
+
+   if (not react) {
+      Claim(type);
+      return;
+   }
+
+   for (auto state : found.GetValue())
+      Repeat(state.mValue);
+}
+
+/// React on a single key auto-repeat                                         
+///   @param e - the repeated event                                           
+void Anticipator::Repeat(const Event& e) {
+   const auto verdict = Permit(e.mType, true);
+   if (verdict == Verdict::Denied)
+      return;
+
+   Accept(e);
+   Claim(e.mType);
+   if (verdict == Verdict::Deferred)
+      return;
+
+   VERBOSE_INPUT("Repeat event triggered: ", mEvent);
+   mFlow.Reset();
+   Execute();
+}
+
+/// Accept a triggering event - its payload and timestamp become the context  
+/// of the flow, while the anticipated type and state remain unchanged        
+///   @param e - the triggering event                                         
+void Anticipator::Accept(const Event& e) {
+   mEvent.mPayload = e.mPayload;
+   mEvent.mTimestamp = e.mTimestamp;
+   mTrigger = e.mType;
+}
+
+/// Stop the triggering event from propagating to listeners of lower          
+/// priority, if the policy requires it                                       
+///   @param type - the type of the triggering event                          
+void Anticipator::Claim(DMeta type) {
+   if (mPolicy.mConsume)
+      GetProducer()->GetProducer()->StopPropagation(type);
+}
+
+/// Check if the anticipator's policy permits an event to trigger it          
+/// Triggers within the cooldown or debounce window are dropped, and counted  
+/// in the module's metrics. Triggers that only came too soon for the         
+/// throttle are deferred instead - the latest of them is executed from       
+/// Tick(), as soon as the throttle window expires. Windows are measured      
+/// from the times events occurred at, so a frame hitch doesn't bunch them    
+///   @param type - the type of the triggering event                          
+///   @param lockout - whether to lock the anticipator out for the throttle   
+///      and cooldown time - 'hold' anticipators are instead locked out when  
+///      they're released, and throttled on each tick                         
+///   @return whether the trigger is denied, deferred, or may execute now     
+Anticipator::Verdict Anticipator::Permit(DMeta type, bool lockout) {
+   if (not mGated)
+      return Verdict::Permitted;
+
+   const auto now = GetProducer()->GetModule()->GetOccurrence(type);
+   bool permitted = now >= mNextTrigger;
+   if (mDebounce) {
+      // Each event restarts the debounce window, even if denied        
+      permitted &= not mLastSeen or now - mLastSeen >= mDebounce;
+      mLastSeen = now;
+   }
+
+   if (not permitted) {
+      ++GetProducer()->GetModule()->GetMetrics().mCurrent.mDenied;
+      return Verdict::Denied;
+   }
+
+   if (not lockout)
+      return Verdict::Permitted;
+
+   if (now < mNextThrottle) {
+      mDeferred = true;
+      mDeferredSince = now;
+      return Verdict::Deferred;
+   }
+
+   mNextTrigger = now + mCooldown;
+   mNextThrottle = now + mThrottle;
+   mDeferred = false;
+   return Verdict::Permitted;
+}
+
+/// Tick an active 'hold' anticipator, limiting its rate if policy requires   
+/// it - the time of the skipped ticks is accumulated, so that scripts that   
+/// depend on the time delta don't slow down. Anticipators that aren't active 
+/// are ticked only while they have a deferred trigger, see Permit()          
+///   @param deltaTime - time since last tick                                 
+///   @return true if the anticipator needs to be ticked again                
+bool Anticipator::Tick(const Time& deltaTime) {
+   // Holds bound to an action end, if the action was rebound meanwhile 
+   if (mAction)
+      Resolve();
+
+   if (not mActive) {
+      if (not mDeferred)
+         return false;
+
+      const auto now = SDL_GetTicksNS();
+      if (now < mNextThrottle)
+         return true;
+
+      VERBOSE_INPUT("Throttled event triggered: ", mEvent);
+      mNextTrigger = now + mCooldown;
+      mNextThrottle = now + mThrottle;
+      mFlow.Reset();
+      Execute();
+      mDeferred = false;
+      return false;
+   }
+
+   VERBOSE_INPUT("Hold event triggered: ", mEvent);
+   if (not mThrottle) {
+      Execute(deltaTime);
+      return true;
+   }
+
+   mSkipped += deltaTime;
+   const auto now = SDL_GetTicksNS();
+   if (now < mNextTick) {
+      ++GetProducer()->GetModule()->GetMetrics().mCurrent.mDenied;
+      return true;
+   }
+
+   mNextTick = now + mThrottle;
+   Execute(mSkipped);
+   mSkipped = {};
+   return true;
+}
+
+/// Execute the anticipator's flow, measuring the time it took                
+///   @param deltaTime - time since last execution, if this is a hold event   
+void Anticipator::Execute(const Time& deltaTime) {
+   auto& metrics = GetProducer()->GetModule()->GetMetrics().mCurrent;
+   const auto start = SDL_GetTicksNS();
+
+   Many unusedSideEffects;
+   mFlow.Update(deltaTime, unusedSideEffects);
+
+   const auto end = SDL_GetTicksNS();
+   ++metrics.mScripts;
+   metrics.mScripting += end - start;
+
+   // Sample the latency of the triggering event - ticks of an active   
+   // 'hold' aren't triggered by any event. A deferred trigger executes 
+   // after the frame that delivered its event, and samples it directly 
+   auto& module = *GetProducer()->GetModule();
+   if (mDeferred)
+      module.GetMetrics().Sampled(mDeferredSince, end);
+   else if (not mActive)
+      module.GetMetrics().Triggered(mTrigger, end);
 }
 
 /// Stringify the anticipator                                                 
 Anticipator::operator Text() const {
+   if (mAction) {
+      return Text::TemplateRt(
+         "{}({}, {})", MetaOf<Anticipator>(), mAction, mScript
+      );
+   }
+
    return Text::TemplateRt(
       "{}({}, {})", MetaOf<Anticipator>(), mEvent.mType, mScript
    );
@@ -15,6 +15,55 @@
 struct Anticipator;
 
 
+///                                                                           
+///   Anticipator policy                                                      
+///                                                                           
+/// Optional part of an anticipator's descriptor, that changes when the       
+/// anticipator is triggered                                                  
+///                                                                           
+struct AnticipatorPolicy {
+   LANGULUS(POD) true;
+   LANGULUS(NULLIFIABLE) true;
+
+   // React on key auto-repeats generated by the OS, while a key is     
+   // held - useful for text fields and similar. Repeats are dropped    
+   // at the source, unless at least one anticipator opts in            
+   bool mRepeat = false;
+   // Stop the triggering event from reaching listeners of lower        
+   // priority - useful for modal UI, capturing input from the game.    
+   // Holds below that are already active are still released on End.    
+   // Auto-repeats of the consumed keys are consumed along with them    
+   bool mConsume = false;
+   // Minimum time between two executions of the script, including the  
+   // ticks of 'hold' anticipators - caps the cost of auto-fire keys.   
+   // Unlike cooldown, triggers arriving too soon aren't dropped - the  
+   // latest of them is deferred until the window expires               
+   Time mThrottle {};
+   // Events that arrive sooner than this after the previous one are    
+   // considered noise and ignored, each of them restarting the window  
+   Time mDebounce {};
+   // Time after a trigger, or after a 'hold' is released, during       
+   // which the anticipator can't be triggered again                    
+   Time mCooldown {};
+};
+
+
+///                                                                           
+///   Listener policy                                                         
+///                                                                           
+/// Optional part of an input listener's descriptor                           
+///                                                                           
+struct ListenerPolicy {
+   LANGULUS(POD) true;
+   LANGULUS(NULLIFIABLE) true;
+
+   // Listeners of higher priority react on events first, and can       
+   // consume them, so they never reach the lower priority ones.        
+   // Listeners of equal priority always see the same events            
+   int mPriority = 0;
+};
+
+
 ///                                                                           
 ///   Input listener                                                          
 ///                                                                           
@@ -30,16 +79,64 @@ private:
    // Control factor (zero means no control, 1 means full control)      
    // Acts as mass modifier for executed scripts                        
    Real mControlFactor = 1;
+   // Optional policy, changing the order in which listeners react      
+   ListenerPolicy mPolicy;
+
+   // Hot matching data of all anticipators, kept in parallel arrays,   
+   // so that matching only touches tightly packed memory. Declared     
+   // before mAnticipators, so that it outlives them on destruction     
+   // Anticipated event type, null if anticipator is bound to action    
+   TMany<DMeta> mHotTypes;
+   // Mask of event states the anticipator may react on                 
+   TMany<uint8_t> mHotStates;
+   // Whether anticipator is an active 'hold' event, or has a deferred  
+   // trigger - either way it has to be ticked on each update           
+   TMany<uint8_t> mHotActive;
+   // Number of anticipators that have to be ticked                     
+   Count mActiveCount = 0;
+   // Scratch mask of anticipators that matched in the current update   
+   TMany<uint8_t> mHotMatched;
+   // The anticipators themselves, that contain the cold data - null    
+   // for anticipators removed during a dispatch, until it's over       
+   TMany<Anticipator*> mCold;
+
+   // Number of dispatches in progress - scripts may create and destroy 
+   // anticipators, so the hot arrays are resized only between them     
+   Count mDispatching = 0;
+   // Anticipators created during a dispatch, registered after it       
+   TMany<Anticipator*> mPending;
+   // Whether any slot was vacated during a dispatch                    
+   bool mVacated = false;
+
    // Anticipators that react on events                                 
    TFactoryUnique<Anticipator> mAnticipators;
+   // Set once detached from the gatherer, see Detach()                 
+   bool mDetached = false;
+
+   struct Dispatching;
 
    void AutoBind();
+   void Match(const EventList&);
+   void Detach();
+   void Append(Anticipator*);
+   void Remove(Offset);
+   void Flush();
 
 public:
-   InputListener(InputGatherer*, const Many&);
+    InputListener(InputGatherer*, const Many&);
+   ~InputListener();
 
    void Create(Verb&);
-   void Update(const Time&, const EventList&);
+   void Update(const Time&);
+   void Dispatch(const EventList&);
+   void Repeat(const EventList&);
+   void Release(const EventList&);
+   InputSDL* GetModule() const noexcept;
+   bool IsActive() const noexcept;
+   int GetPriority() const noexcept;
+
+   void Register(Anticipator*);
+   void Unregister(Anticipator*);
    void Refresh();
    void Teardown();
 };
@@ -59,21 +156,74 @@ struct Anticipator : Referenced, ProducedFrom<InputListener> {
    // Event and state on which anticipator reacts                       
    // Contained payload acts as a context for the precompiled flow      
    Event mEvent;
+   // Optional policy, changing when the anticipator is triggered       
+   AnticipatorPolicy mPolicy;
+   // Named action, if anticipator is bound to an action instead of a   
+   // concrete event type - the gatherer's action map resolves it       
+   Text mAction;
+   // Events the action resolved to, and the generation of the action   
+   // map they were resolved from                                       
+   const TMany<DMeta>* mActionEvents {};
+   Count mActionGeneration = 0;
+   // Type of the last accepted event, may differ from mEvent.mType if  
+   // the anticipator is bound to an action                             
+   DMeta mTrigger;
    // Marks the anticipator as active in case of Begin/End events       
    bool mActive = false;
+   // Index of the anticipator in the listener's hot arrays             
+   Offset mSlot = 0;
+   // Policy limits in nanoseconds, and whether any of them is set      
+   Uint64 mThrottle = 0;
+   Uint64 mDebounce = 0;
+   Uint64 mCooldown = 0;
+   bool mGated = false;
+   // Earliest time the anticipator may trigger again due to cooldown,  
+   // and time of the last event it has seen, used for debouncing       
+   Uint64 mNextTrigger = 0;
+   Uint64 mLastSeen = 0;
+   // Earliest time the anticipator may execute again due to throttle,  
+   // whether a throttled trigger waits to be executed then, and the    
+   // time of the event that caused it, sampled as its latency          
+   Uint64 mNextThrottle = 0;
+   bool mDeferred = false;
+   Uint64 mDeferredSince = 0;
+   // Earliest time a 'hold' anticipator may tick again, and the time   
+   // of the ticks skipped in the meantime                              
+   Uint64 mNextTick = 0;
+   Time mSkipped {};
    // Script                                                            
    Code mScript;
    // Precompiled mScript to execute as event reaction                  
    Temporal mFlow;
+   // Set once detached from the listener, see Detach()                 
+   bool mDetached = false;
 
 public:
    Anticipator(InputListener*, const Many&);
+   ~Anticipator();
+
+   void Detach();
 
    bool Interact(const EventList&);
+   bool Release(const EventList&);
+   void Repeat(const EventList&);
+   bool Tick(const Time&);
+   void Execute(const Time& = {});
 
    explicit operator Text() const;
 
 protected:
+   // Outcome of checking a trigger against the policy                  
+   enum class Verdict {Denied, Deferred, Permitted};
+
+   void Resolve();
+   void Match(const EventList&, DMeta);
+   void Repeat(const EventList&, DMeta, bool);
+   void Repeat(const Event&);
+   void Accept(const Event&);
+   void Claim(DMeta);
+   Verdict Permit(DMeta, bool);
+
    Text Self() const { return operator Text() + ": "; }
 };
 
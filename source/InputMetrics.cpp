@@ -0,0 +1,107 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "InputMetrics.hpp"
+#include <cmath>
+
+
+/// Register the time an event occurred, so that its latency can be sampled,  
+/// if it triggers a script. Only the earliest time of each event type is     
+/// kept, since events of the same type are merged into one                   
+///   @param type - the type of the event                                     
+///   @param timestamp - the SDL timestamp of the event                       
+void InputMetrics::Occurred(DMeta type, Uint64 timestamp) {
+   if (not type or not timestamp or mPending.FindIt(type))
+      return;
+   mPending.Insert(type, timestamp);
+}
+
+/// Register that a script was executed in reaction to an event, sampling     
+/// the event's latency into the rolling histogram. Each event is sampled     
+/// only once, even if it triggered several scripts                           
+///   @param type - the type of the triggering event                          
+///   @param now - the SDL time at which the script finished executing        
+void InputMetrics::Triggered(DMeta type, Uint64 now) {
+   const auto found = mPending.FindIt(type);
+   if (not found)
+      return;
+
+   const auto timestamp = found.GetValue();
+   mPending.RemoveKey(type);
+   Sampled(timestamp, now);
+}
+
+/// Sample a latency into the rolling histogram                               
+///   @param timestamp - the SDL time the triggering event occurred at        
+///   @param now - the SDL time at which the script finished executing        
+void InputMetrics::Sampled(Uint64 timestamp, Uint64 now) {
+   const Uint64 micro = now > timestamp ? (now - timestamp) / 1000 : 0;
+   uint8_t bucket = 0;
+   while (bucket < LatencyBuckets - 1 and (Uint64 {2} << bucket) <= micro)
+      ++bucket;
+
+   // Forget the oldest sample, if window is full                       
+   if (mLatencySamples == LatencyWindow)
+      --mLatency[mLatencyWindow[mLatencyHead]];
+   else
+      ++mLatencySamples;
+
+   mLatencyWindow[mLatencyHead] = bucket;
+   ++mLatency[bucket];
+   mLatencyHead = (mLatencyHead + 1) % LatencyWindow;
+}
+
+/// Forget the times of all events delivered so far - those that didn't       
+/// trigger any scripts don't contribute latency                              
+void InputMetrics::Delivered() {
+   mPending.Clear();
+}
+
+/// Publish the current frame's metrics and start a new frame                 
+void InputMetrics::EndFrame() {
+   mLast = mCurrent;
+   mCurrent = {};
+   Delivered();
+}
+
+/// Get the number of samples in the rolling latency histogram                
+///   @return the number of samples                                           
+Count InputMetrics::GetLatencySamples() const noexcept {
+   return mLatencySamples;
+}
+
+/// Get the number of samples in a latency bucket                             
+///   @param bucket - the bucket index, see mLatency                          
+///   @return the number of samples in the bucket                             
+Count InputMetrics::GetLatencyBucket(Offset bucket) const noexcept {
+   return bucket < LatencyBuckets ? mLatency[bucket] : 0;
+}
+
+/// Estimate a latency percentile from the rolling histogram                  
+///   @param percentile - in the range [0; 1]                                 
+///   @return the upper bound of the bucket that contains the percentile, in  
+///      nanoseconds, or zero if no samples were collected yet                
+Uint64 InputMetrics::GetLatencyPercentile(Real percentile) const noexcept {
+   if (not mLatencySamples)
+      return 0;
+
+   // The percentile lies in the first bucket, at which the number of   
+   // accumulated samples reaches its rank - ranks start at one, so p0  
+   // is the fastest sample, and p100 is the slowest one                
+   const auto wanted = std::ceil(percentile * mLatencySamples);
+   const auto target = wanted < 1 ? Count {1}
+      : wanted > mLatencySamples ? mLatencySamples
+      : static_cast<Count>(wanted);
+
+   Count accumulated = 0;
+   for (Offset bucket = 0; bucket < LatencyBuckets; ++bucket) {
+      accumulated += mLatency[bucket];
+      if (accumulated >= target)
+         return (Uint64 {2} << bucket) * 1000;
+   }
+   return 0;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+
+///                                                                           
+///   Input pipeline metrics                                                  
+///                                                                           
+/// Counters and timings for each stage of the input pipeline, accumulated    
+/// during a frame and published at the end of InputSDL::Update. Also keeps   
+/// a rolling histogram of the latency between an event's SDL timestamp and   
+/// the execution of the script it triggered - events that trigger nothing    
+/// aren't sampled. All times are in nanoseconds, as reported by SDL_GetTicksNS
+///                                                                           
+struct InputMetrics {
+   static constexpr Count LatencyBuckets = 24;
+   static constexpr Count LatencyWindow = 256;
+
+   struct Frame {
+      // Number of SDL events drained from the SDL queue                
+      Count mDrained = 0;
+      // Number of Langulus events produced from SDL events             
+      Count mTranslated = 0;
+      // Number of events merged into an already existing event         
+      Count mCoalesced = 0;
+      // Number of visited gatherers and listeners                      
+      Count mGatherers = 0;
+      Count mListeners = 0;
+      // Number of anticipators matched against events                  
+      Count mAnticipators = 0;
+      // Number of executed anticipator scripts                         
+      Count mScripts = 0;
+      // Number of triggers and ticks denied by anticipator policies    
+      Count mDenied = 0;
+      // Number of new event groups, window queues and ingested batches 
+      // These are the points where the pipeline may allocate, instead  
+      // of merging into existing storage - not an exact allocation count
+      Count mInsertions = 0;
+      // Wall time spent in each stage                                  
+      Uint64 mPolling = 0;
+      Uint64 mDispatch = 0;
+      Uint64 mScripting = 0;
+   };
+
+   // Metrics of the frame that is currently being processed            
+   Frame mCurrent;
+   // Metrics of the last completed frame                               
+   Frame mLast;
+   // Time spent starting SDL subsystems, including lazy ones           
+   Uint64 mStartup = 0;
+
+private:
+   // Number of latency samples in each bucket - bucket N contains      
+   // latencies in the range [2^N, 2^(N+1)) microseconds, and bucket    
+   // zero contains everything below two microseconds                   
+   Count mLatency[LatencyBuckets] {};
+   // Bucket of each sample in the rolling window                       
+   uint8_t mLatencyWindow[LatencyWindow] {};
+   Count mLatencySamples = 0;
+   Offset mLatencyHead = 0;
+
+   // Time of the earliest event of each type drained during the frame  
+   // Events of the same type are merged, so they share their latency   
+   TUnorderedMap<DMeta, Uint64> mPending;
+
+public:
+   void Occurred(DMeta, Uint64);
+   void Triggered(DMeta, Uint64);
+   void Sampled(Uint64, Uint64);
+   void Delivered();
+   void EndFrame();
+
+   Count GetLatencySamples() const noexcept;
+   Count GetLatencyBucket(Offset) const noexcept;
+   Uint64 GetLatencyPercentile(Real) const noexcept;
+};
\ No newline at end of file
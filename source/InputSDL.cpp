@@ -6,34 +6,56 @@
 /// SPDX-License-Identifier: GPL-3.0-or-later                                 
 ///                                                                           
 #include "InputSDL.hpp"
-
-LANGULUS_DEFINE_MODULE(
-   InputSDL, 0, "InputSDL",
-   "Raw input module, using SDL as backend - "
-   "allows for raw mouse/joystick/keyboard inputs even on console applications, "
-   "by using an external window", "",
-   InputSDL, InputGatherer, InputListener, Anticipator
-)
+#include <algorithm>
 
 
 DMeta TranslateKey(SDL_Scancode);
+DMeta FindKey(SDL_Scancode);
 DMeta TranslateMouse(Uint8);
 
 /// Module construction                                                       
 ///   @param runtime - the runtime that owns the module                       
 ///   @param descriptor - instructions for configuring the module             
-InputSDL::InputSDL(Runtime* runtime, const Many&)
+InputSDL::InputSDL(Runtime* runtime, const Many& descriptor)
    : Resolvable{this}
    , A::Module {runtime} {
    // Reflect all event tokens                                          
    Langulus::RegisterEvents();
 
-   // Initialize SDL for input                                          
+   // Initialize only the SDL event subsystem - video and gamepad       
+   // subsystems are started on demand, see Acquire()                   
    VERBOSE_INPUT("Initializing...");
-   LANGULUS_ASSERT(SDL_Init(SDL_INIT_GAMEPAD) >= 0, Construct,
+   const auto startup = std::chrono::steady_clock::now();
+   LANGULUS_ASSERT(SDL_Init(SDL_INIT_EVENTS) >= 0, Construct,
       "SDL failed to initialize - no input will be available. SDL_Error: ",
       SDL_GetError()
    );
+
+   // Events that aren't translated yet can't have subscribers          
+   SDL_SetEventEnabled(SDL_EVENT_JOYSTICK_AXIS_MOTION, false);
+   SDL_SetEventEnabled(SDL_EVENT_JOYSTICK_BALL_MOTION, false);
+   SDL_SetEventEnabled(SDL_EVENT_JOYSTICK_BUTTON_DOWN, false);
+   SDL_SetEventEnabled(SDL_EVENT_JOYSTICK_BUTTON_UP, false);
+   SDL_SetEventEnabled(SDL_EVENT_JOYSTICK_HAT_MOTION, false);
+   SDL_SetEventEnabled(SDL_EVENT_GAMEPAD_AXIS_MOTION, false);
+   SDL_SetEventEnabled(SDL_EVENT_GAMEPAD_BUTTON_DOWN, false);
+   SDL_SetEventEnabled(SDL_EVENT_GAMEPAD_BUTTON_UP, false);
+   SDL_SetEventEnabled(SDL_EVENT_CLIPBOARD_UPDATE, false);
+
+   // Nobody is subscribed yet, so stop all input at the source         
+   for (int i = 0; i < static_cast<int>(InputCategory::Counter); ++i)
+      Toggle(static_cast<InputCategory>(i), false);
+
+   // Optional idle mode, see Update()                                  
+   descriptor.ForEachDeep([&](const InputIdle& idle) {
+      SetIdleTimeout(idle.mTimeout);
+   });
+
+   mMetrics.mStartup = static_cast<Uint64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now() - startup
+      ).count()
+   );
    VERBOSE_INPUT("Initialized");
 }
 
@@ -42,6 +64,9 @@ InputSDL::~InputSDL() {
    mGlobalEvents.Reset();
    mGatherers.Reset();
 
+   mDevices.Reset();
+   EnableSensors(false);
+
    SDL_Quit();
 }
 
@@ -55,112 +80,404 @@ void InputSDL::Teardown() {
 ///   @return false if the UI requested exit                                  
 bool InputSDL::Update(Time deltaTime) {
    LANGULUS(PROFILE);
-   Math::Vec2f mouseMovement;
-   Math::Vec2f mouseScroll;
-   SDL_Event e;
+   if (mQuitRequested)
+      return false;
 
-   while (SDL_PollEvent(&e) != 0) {
-      switch (e.type) {
-      case SDL_EVENT_QUIT:
-         // User requests quit                                          
-         return false;
-      case SDL_EVENT_JOYSTICK_AXIS_MOTION:
-         VERBOSE_INPUT("Joystick axis motion");
-         TODO();
-         break;
-      case SDL_EVENT_JOYSTICK_BALL_MOTION:
-         VERBOSE_INPUT("Joystick ball motion");
-         TODO();
-         break;
-      case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
-         VERBOSE_INPUT("Joystick button down");
-         TODO();
-         break;
-      case SDL_EVENT_JOYSTICK_BUTTON_UP:
-         VERBOSE_INPUT("Joystick button up");
-         TODO();
-         break;
-      case SDL_EVENT_JOYSTICK_HAT_MOTION:
-         VERBOSE_INPUT("Joystick hat motion");
-         TODO();
-         break;
-      case SDL_EVENT_CLIPBOARD_UPDATE:
-         VERBOSE_INPUT("Clipboard change detected");
-         TODO();
-         break;
-      case SDL_EVENT_MOUSE_MOTION:
-         // Mouse moved                                                 
-         mouseMovement.x += e.motion.xrel;
-         mouseMovement.y += e.motion.yrel;
-         break;
-      case SDL_EVENT_MOUSE_WHEEL:
-         // Mouse scrolled                                              
-         mouseScroll.x += e.wheel.x;
-         mouseScroll.y += e.wheel.y;
-         break;
-      case SDL_EVENT_MOUSE_BUTTON_DOWN: {
-         // Mouse key was pressed                                       
-         Event newEvent;
-         newEvent.mType = TranslateMouse(e.button.button);
-         newEvent.mState = EventState::Begin;
-         VERBOSE_INPUT("Mouse button pressed: ", newEvent.mType.GetToken());
-         PushEvent(newEvent);
-         break;
-      }
-      case SDL_EVENT_MOUSE_BUTTON_UP: {
-         // Mouse key was released                                      
-         Event newEvent;
-         newEvent.mType = TranslateMouse(e.button.button);
-         newEvent.mState = EventState::End;
-         VERBOSE_INPUT("Mouse button released: ", newEvent.mType.GetToken());
-         PushEvent(newEvent);
-         break;
+   // Nothing to do - sleep until input arrives, or until timeout       
+   if (mIdleTimeout and not HasPendingWork() and not Idle())
+      return false;
+
+   // Drain and translate all events since the last update/sample       
+   const auto pollStart = SDL_GetTicksNS();
+   if (not Poll())
+      return false;
+
+   const auto dispatchStart = SDL_GetTicksNS();
+   mMetrics.mCurrent.mPolling += dispatchStart - pollStart;
+
+   // Deliver window-specific events only to the gatherers that own     
+   // the corresponding windows                                         
+   for (auto pair : mWindowEvents) {
+      auto owner = mWindowOwners.FindIt(pair.mKey);
+      if (owner)
+         owner.GetValue()->Receive(pair.mValue);
+   }
+
+   for (auto pair : mWindowRepeats) {
+      auto owner = mWindowOwners.FindIt(pair.mKey);
+      if (owner)
+         owner.GetValue()->Repeat(pair.mValue);
+   }
+
+   mWindowEvents.Clear();
+   mWindowRepeats.Clear();
+
+   // Update all gatherers                                              
+   for (auto& gatherer : mGatherers) {
+      ++mMetrics.mCurrent.mGatherers;
+      gatherer.Update(deltaTime, mGlobalEvents, mRepeats);
+   }
+
+   mGlobalEvents.Clear();
+   mRepeats.Clear();
+
+   // Snapshot the input of this frame                                  
+   mHistory.Commit();
+
+   // Publish metrics for this frame - latency was already sampled by   
+   // each script, for the event that triggered it                      
+   mMetrics.mCurrent.mDispatch += SDL_GetTicksNS() - dispatchStart;
+   mMetrics.EndFrame();
+   mOccurred.Clear();
+   return true;
+}
+
+/// Late input sampling - can be called by other modules (like a renderer)    
+/// right before they need input-dependent state. Drains and translates only  
+/// the events since the last update/sample, and dispatches them directly to  
+/// the listeners, without ticking hold events or consuming gatherer queues.  
+/// The next Update will not deliver these events again. Latency of scripts   
+/// triggered here is sampled like in Update, see InputMetrics                
+///   @return false if the UI requested exit                                  
+bool InputSDL::Sample() {
+   LANGULUS(PROFILE);
+   if (mQuitRequested)
+      return false;
+
+   const auto pollStart = SDL_GetTicksNS();
+   if (not Poll())
+      return false;
+
+   const auto dispatchStart = SDL_GetTicksNS();
+   mMetrics.mCurrent.mPolling += dispatchStart - pollStart;
+
+   // Window-specific events go only to the gatherers that own them     
+   for (auto pair : mWindowEvents) {
+      auto owner = mWindowOwners.FindIt(pair.mKey);
+      if (owner)
+         owner.GetValue()->Dispatch(pair.mValue);
+   }
+
+   for (auto pair : mWindowRepeats) {
+      auto owner = mWindowOwners.FindIt(pair.mKey);
+      if (owner)
+         owner.GetValue()->Repeat(pair.mValue);
+   }
+
+   mWindowEvents.Clear();
+   mWindowRepeats.Clear();
+
+   if (mGlobalEvents or mRepeats) {
+      for (auto& gatherer : mGatherers) {
+         ++mMetrics.mCurrent.mGatherers;
+         if (mGlobalEvents)
+            gatherer.Dispatch(mGlobalEvents);
+         if (mRepeats)
+            gatherer.Repeat(mRepeats);
       }
-      case SDL_EVENT_WINDOW_FOCUS_LOST: {
-         // Input focus lost - pause game, etc.?                        
-         VERBOSE_INPUT("Focus lost");
-         PushEvent(Events::WindowUnfocus {});
-         break;
+
+      mGlobalEvents.Clear();
+      mRepeats.Clear();
+   }
+
+   // Scripts run by the sample already sampled their latency - forget  
+   // the rest of the sampled events, so that they aren't attributed to 
+   // triggers of the same type during the next update                  
+   mMetrics.Delivered();
+   mOccurred.Clear();
+   mMetrics.mCurrent.mDispatch += SDL_GetTicksNS() - dispatchStart;
+   return true;
+}
+
+/// Start an SDL subsystem on demand - subsystems are reference counted, and  
+/// are shut down when the last user releases them                            
+///   @param subsystem - the SDL_INIT_* flag of the subsystem                 
+///   @return true if the subsystem is available                              
+bool InputSDL::Acquire(Uint32 subsystem) {
+   const auto found = mSubsystems.FindIt(subsystem);
+   if (found) {
+      ++found.GetValue();
+      return true;
+   }
+
+   const auto start = SDL_GetTicksNS();
+   if (SDL_InitSubSystem(subsystem) < 0) {
+      Logger::Warning(Self(),
+         "SDL failed to initialize subsystem ", subsystem,
+         ". SDL_Error: ", SDL_GetError()
+      );
+      return false;
+   }
+
+   mSubsystems.Insert(subsystem, Count {1});
+   mMetrics.mStartup += SDL_GetTicksNS() - start;
+   VERBOSE_INPUT("SDL subsystem ", subsystem, " started");
+   return true;
+}
+
+/// Release an SDL subsystem, previously started via Acquire()                
+///   @param subsystem - the SDL_INIT_* flag of the subsystem                 
+void InputSDL::Release(Uint32 subsystem) {
+   const auto found = mSubsystems.FindIt(subsystem);
+   LANGULUS_ASSUME(DevAssumes, found,
+      "Releasing an SDL subsystem that was never acquired");
+   if (--found.GetValue())
+      return;
+
+   mSubsystems.RemoveKey(subsystem);
+   SDL_QuitSubSystem(subsystem);
+   VERBOSE_INPUT("SDL subsystem ", subsystem, " shut down");
+}
+
+/// Get the number of users of an SDL subsystem                               
+///   @param subsystem - the SDL_INIT_* flag of the subsystem                 
+///   @return the number of Acquire() calls not yet released, the subsystem   
+///      is started by this module only while it's non-zero                   
+Count InputSDL::GetSubsystemUsers(Uint32 subsystem) const noexcept {
+   const auto found = mSubsystems.FindIt(subsystem);
+   return found ? found.GetValue() : 0;
+}
+
+/// Check if there's any input work pending, so that the runtime knows        
+/// whether it can sleep instead of updating                                  
+///   @return true if there are untranslated, undelivered or queued events,   
+///      or active 'hold' anticipators that need to be ticked                 
+bool InputSDL::HasPendingWork() const {
+   if (mQuitRequested or mGlobalEvents or mWindowEvents or mRepeats or mWindowRepeats)
+      return true;
+
+   if (SDL_HasEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST))
+      return true;
+
+   if (mDevices and EvdevDevice::Wait(mDevices, 0))
+      return true;
+
+   for (auto& gatherer : mGatherers) {
+      if (gatherer.HasPendingWork())
+         return true;
+   }
+   return false;
+}
+
+/// Enable idle mode - when there's no pending work, Update will block until  
+/// input arrives or the timeout expires, instead of spinning                 
+///   @param timeout - the longest time to block, usually the time until the  
+///      runtime's next deadline; zero or negative disables idle mode         
+void InputSDL::SetIdleTimeout(Time timeout) {
+   // A negative timeout would make SDL wait forever, so clamp it       
+   const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+   mIdleTimeout = static_cast<Sint32>(std::clamp<decltype(ms)>(ms, 0, SDL_MAX_SINT32));
+}
+
+/// Block until input arrives from SDL or from any device read directly, or   
+/// until the idle timeout expires                                            
+///   @return false if the UI requested exit                                  
+bool InputSDL::Idle() {
+   if (not mDevices) {
+      SDL_Event e;
+      if (SDL_WaitEventTimeout(&e, mIdleTimeout) and not Translate(e)) {
+         mQuitRequested = true;
+         return false;
       }
-      case SDL_EVENT_WINDOW_FOCUS_GAINED: {
-         // Input focus gained - resume game?                           
-         VERBOSE_INPUT("Focus gained");
-         PushEvent(Events::WindowFocus {});
+      return true;
+   }
+
+   // SDL can't wake up on input from devices read directly, and poll() 
+   // can't wake up on SDL events - wait on the devices in short slices,
+   // checking for SDL events inbetween. Only open devices are kept,    
+   // see Poll()                                                        
+   const Uint64 deadline = SDL_GetTicks() + mIdleTimeout;
+   for (auto now = SDL_GetTicks(); now < deadline; now = SDL_GetTicks()) {
+      const auto slice = std::min<Uint64>(IdleSlice, deadline - now);
+      if (EvdevDevice::Wait(mDevices, static_cast<Sint32>(slice)))
          break;
-      }
-      case SDL_EVENT_KEY_DOWN: {
-         // Keyboard key was pressed down                               
-         Event newEvent;
-         newEvent.mType = TranslateKey(e.key.scancode);
-         newEvent.mState = EventState::Begin;
-         VERBOSE_INPUT("Keyboard button pressed: ", newEvent.mType.GetToken());
-         PushEvent(newEvent);
+
+      SDL_PumpEvents();
+      if (SDL_HasEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST))
          break;
+   }
+   return true;
+}
+
+/// Drain the SDL event queue, translating all events                         
+///   @return false if the UI requested exit                                  
+bool InputSDL::Poll() {
+   SDL_Event e;
+   while (SDL_PollEvent(&e) != 0) {
+      if (not Translate(e)) {
+         mQuitRequested = true;
+         return false;
       }
-      case SDL_EVENT_KEY_UP: {
-         // Keyboard key was released                                   
-         Event newEvent;
-         newEvent.mType = TranslateKey(e.key.scancode);
-         newEvent.mState = EventState::End;
-         VERBOSE_INPUT("Keyboard button released: ", newEvent.mType.GetToken());
-         PushEvent(newEvent);
-         break;
-      }}
    }
 
+   // Read devices that bypass SDL, in the same batch. Unplugged devices
+   // and ended streams are forgotten, so that idle mode doesn't wait on
+   // them - gatherers that still reference them keep a closed device   
+   TMany<Text> closed;
+   for (auto pair : mDevices) {
+      pair.mValue->Read(*this);
+      if (not pair.mValue->IsOpen())
+         closed << pair.mKey;
+   }
+
+   for (auto& path : closed)
+      mDevices.RemoveKey(path);
+
    // Dispatch gathered mouse movement events                           
-   if (mouseMovement)
-      PushEvent(Events::MouseMove   {EventState::Point, mouseMovement});
+   for (auto pair : mMouseMovement) {
+      if (pair.mValue)
+         PushEvent(Events::MouseMove {EventState::Point, pair.mValue}, pair.mKey);
+   }
    
    // Dispatch gathered mouse scroll events                             
-   if (mouseScroll)
-      PushEvent(Events::MouseScroll {EventState::Point, mouseScroll});
+   for (auto pair : mMouseScroll) {
+      if (pair.mValue)
+         PushEvent(Events::MouseScroll {EventState::Point, pair.mValue}, pair.mKey);
+   }
 
-   // Update all gatherers                                              
-   for (auto& gatherer : mGatherers)
-      gatherer.Update(deltaTime, mGlobalEvents);
+   mMouseMovement.Clear();
+   mMouseScroll.Clear();
+
+   // Dispatch gathered gamepad sensor samples                          
+   FlushSensors();
+   return true;
+}
+
+/// Translate a single SDL event into Langulus events                         
+///   @param e - the SDL event                                                
+///   @return false if the UI requested exit                                  
+bool InputSDL::Translate(const SDL_Event& e) {
+   ++mMetrics.mCurrent.mDrained;
+
+   switch (e.type) {
+   case SDL_EVENT_QUIT:
+      // User requests quit                                             
+      return false;
+   case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+      VERBOSE_INPUT("Joystick axis motion");
+      TODO();
+      break;
+   case SDL_EVENT_JOYSTICK_BALL_MOTION:
+      VERBOSE_INPUT("Joystick ball motion");
+      TODO();
+      break;
+   case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+      VERBOSE_INPUT("Joystick button down");
+      TODO();
+      break;
+   case SDL_EVENT_JOYSTICK_BUTTON_UP:
+      VERBOSE_INPUT("Joystick button up");
+      TODO();
+      break;
+   case SDL_EVENT_JOYSTICK_HAT_MOTION:
+      VERBOSE_INPUT("Joystick hat motion");
+      TODO();
+      break;
+   case SDL_EVENT_CLIPBOARD_UPDATE:
+      VERBOSE_INPUT("Clipboard change detected");
+      TODO();
+      break;
+   case SDL_EVENT_MOUSE_MOTION:
+      // Mouse moved                                                    
+      Move(e.motion.windowID, {e.motion.xrel, e.motion.yrel}, e.motion.timestamp);
+      break;
+   case SDL_EVENT_MOUSE_WHEEL:
+      // Mouse scrolled                                                 
+      Scroll(e.wheel.windowID, {e.wheel.x, e.wheel.y}, e.wheel.timestamp);
+      break;
+   case SDL_EVENT_MOUSE_BUTTON_DOWN: {
+      // Mouse key was pressed                                          
+      Event newEvent;
+      newEvent.mType = TranslateMouse(e.button.button);
+      newEvent.mState = EventState::Begin;
+      VERBOSE_INPUT("Mouse button pressed: ", newEvent.mType.GetToken());
+      PushEvent(newEvent, e.button.windowID, e.button.timestamp);
+      break;
+   }
+   case SDL_EVENT_MOUSE_BUTTON_UP: {
+      // Mouse key was released                                         
+      Event newEvent;
+      newEvent.mType = TranslateMouse(e.button.button);
+      newEvent.mState = EventState::End;
+      VERBOSE_INPUT("Mouse button released: ", newEvent.mType.GetToken());
+      PushEvent(newEvent, e.button.windowID, e.button.timestamp);
+      break;
+   }
+   case SDL_EVENT_WINDOW_FOCUS_LOST: {
+      // Input focus lost - pause game, etc.?                           
+      VERBOSE_INPUT("Focus lost");
+      PushEvent(Events::WindowUnfocus {}, e.window.windowID, e.window.timestamp);
+      break;
+   }
+   case SDL_EVENT_WINDOW_FOCUS_GAINED: {
+      // Input focus gained - resume game?                              
+      VERBOSE_INPUT("Focus gained");
+      PushEvent(Events::WindowFocus {}, e.window.windowID, e.window.timestamp);
+      break;
+   }
+   case SDL_EVENT_KEY_DOWN: {
+      if (e.key.repeat) {
+         // OS auto-repeat while key is held - not a real press, so     
+         // drop it, unless somebody explicitly wants repeats           
+         if (mRepeatSubscribers) {
+            Event newEvent;
+            newEvent.mType = TranslateKey(e.key.scancode);
+            newEvent.mState = EventState::Point;
+
+            // Repeats are routed like presses, see PushEvent()         
+            const auto window = Route(e.key.windowID);
+            if (window and not mWindowRepeats.FindIt(window))
+               mWindowRepeats.Insert(window);
+
+            ++mMetrics.mCurrent.mTranslated;
+            Occurred(newEvent.mType, e.key.timestamp);
+            auto& repeats = window ? mWindowRepeats[window] : mRepeats;
+            if (Merge(repeats, newEvent))
+               ++mMetrics.mCurrent.mCoalesced;
+         }
+         break;
+      }
+
+      // Keyboard key was pressed down                                  
+      Event newEvent;
+      newEvent.mType = TranslateKey(e.key.scancode);
+      newEvent.mState = EventState::Begin;
+      VERBOSE_INPUT("Keyboard button pressed: ", newEvent.mType.GetToken());
+      PushEvent(newEvent, e.key.windowID, e.key.timestamp);
+      break;
+   }
+   case SDL_EVENT_GAMEPAD_ADDED:
+      OpenGamepad(e.gdevice.which);
+      break;
+   case SDL_EVENT_GAMEPAD_REMOVED:
+      CloseGamepad(e.gdevice.which);
+      break;
+   case SDL_EVENT_GAMEPAD_SENSOR_UPDATE: {
+      // Samples are only collected here, and are delivered as a single 
+      // batch per gamepad at the end of the poll, see FlushSensors()   
+      const auto found = mSensorDevices.FindIt(e.gsensor.which);
+      if (not found)
+         break;
+
+      auto& batch = found.GetValue().mBatch;
+      const auto timestamp = e.gsensor.sensor_timestamp
+         ? e.gsensor.sensor_timestamp : e.gsensor.timestamp;
+      if (e.gsensor.sensor == SDL_SENSOR_GYRO)
+         batch.mGyro.Push(timestamp, e.gsensor.data);
+      else if (e.gsensor.sensor == SDL_SENSOR_ACCEL)
+         batch.mAccel.Push(timestamp, e.gsensor.data);
+      break;
+   }
+   case SDL_EVENT_KEY_UP: {
+      // Keyboard key was released                                      
+      Event newEvent;
+      newEvent.mType = TranslateKey(e.key.scancode);
+      newEvent.mState = EventState::End;
+      VERBOSE_INPUT("Keyboard button released: ", newEvent.mType.GetToken());
+      PushEvent(newEvent, e.key.windowID, e.key.timestamp);
+      break;
+   }}
 
-   mGlobalEvents.Clear();
    return true;
 }
 
@@ -170,30 +487,556 @@ void InputSDL::Create(Verb& verb) {
    mGatherers.Create(this, verb);
 }
 
-/// Push a global event, that will be propagated to all gatherers             
+/// Push an event, that will be propagated to the gatherer that owns the      
+/// window the event occured in, or to all gatherers if window isn't owned    
 ///   @param e - event to push                                                
-void InputSDL::PushEvent(const Event& e) {
-   const auto foundEvent = mGlobalEvents.FindIt(e.mType);
+///   @param window - the SDL window the event occured in (optional)          
+///   @param timestamp - the SDL time the event occured at, used to measure   
+///      latency if the event triggers a script (optional)                    
+void InputSDL::PushEvent(const Event& e, SDL_WindowID window, Uint64 timestamp) {
+   ++mMetrics.mCurrent.mTranslated;
+   Occurred(e.mType, timestamp);
+   if (mHistory.IsEnabled())
+      mHistory.Record(e);
+
+   window = Route(window);
+   if (not window) {
+      if (Merge(mGlobalEvents, e))
+         ++mMetrics.mCurrent.mCoalesced;
+      return;
+   }
+
+   if (not mWindowEvents.FindIt(window)) {
+      mWindowEvents.Insert(window);
+      ++mMetrics.mCurrent.mInsertions;
+   }
+
+   if (Merge(mWindowEvents[window], e))
+      ++mMetrics.mCurrent.mCoalesced;
+}
+
+/// Push a relative mouse motion - motions are accumulated, and pushed as a   
+/// single MouseMove event per window at the end of each poll                 
+///   @param window - the SDL window the motion occured in, zero if none      
+///   @param delta - the relative motion                                      
+///   @param timestamp - time of the motion, as reported by SDL_GetTicksNS    
+void InputSDL::Move(SDL_WindowID window, const Math::Vec2f& delta, Uint64 timestamp) {
+   Accumulate(mMouseMovement, window, delta);
+   Occurred(MetaOf<Events::MouseMove>(), timestamp);
+   if (mPredictMouse)
+      mMousePredictor.Sample(timestamp, delta);
+   if (mHistory.IsEnabled())
+      mHistory.RecordMouse(delta);
+}
+
+/// Push a relative mouse scroll - scrolls are accumulated, and pushed as a   
+/// single MouseScroll event per window at the end of each poll               
+///   @param window - the SDL window the scroll occured in, zero if none      
+///   @param delta - the relative scroll                                      
+///   @param timestamp - time of the scroll, as reported by SDL_GetTicksNS    
+void InputSDL::Scroll(SDL_WindowID window, const Math::Vec2f& delta, Uint64 timestamp) {
+   Accumulate(mMouseScroll, window, delta);
+   Occurred(MetaOf<Events::MouseScroll>(), timestamp);
+   if (mHistory.IsEnabled())
+      mHistory.RecordScroll(delta);
+}
+
+/// Accumulate a relative motion for the window it occured in                 
+///   @param accumulator - where to accumulate                                
+///   @param window - the SDL window the motion occured in                    
+///   @param delta - the relative motion                                      
+void InputSDL::Accumulate(
+   TUnorderedMap<SDL_WindowID, Math::Vec2f>& accumulator,
+   SDL_WindowID window, const Math::Vec2f& delta
+) {
+   window = Route(window);
+   const auto found = accumulator.FindIt(window);
+   if (found) {
+      found.GetValue() += delta;
+      ++mMetrics.mCurrent.mCoalesced;
+   }
+   else accumulator.Insert(window, delta);
+}
+
+/// Merge an event into an event list                                         
+///   @param list - the list to merge with                                    
+///   @param e - event to merge                                               
+///   @return true if event was coalesced with an already existing one        
+bool InputSDL::Merge(EventList& list, const Event& e) {
+   const auto foundEvent = list.FindIt(e.mType);
    if (foundEvent) {
       const auto foundState = foundEvent.GetValue().FindIt(e.mState);
       if (foundState) {
          // Event already exists, merge payload                         
          foundState.GetValue().mPayload += e.mPayload;
-         return;
+         return true;
       }
       foundEvent.GetValue().Insert(e.mState, e);
    }
    else {
-      mGlobalEvents.Insert(e.mType);
-      auto& newGroup = mGlobalEvents[e.mType];
+      list.Insert(e.mType);
+      auto& newGroup = list[e.mType];
       newGroup.Insert(e.mState, e);
+      ++mMetrics.mCurrent.mInsertions;
+   }
+
+   return false;
+}
+
+/// Register the time an event occurred at, for latency metrics and for the   
+/// policies of the anticipators it might trigger                             
+///   @param type - the type of the event                                     
+///   @param timestamp - the SDL time of the event, zero if unknown           
+void InputSDL::Occurred(DMeta type, Uint64 timestamp) {
+   mMetrics.Occurred(type, timestamp);
+   if (not timestamp)
+      return;
+
+   const auto found = mOccurred.FindIt(type);
+   if (not found)
+      mOccurred.Insert(type, timestamp);
+   else if (found.GetValue() < timestamp)
+      found.GetValue() = timestamp;
+}
+
+/// Get the time the latest event of a type occurred at, among the events     
+/// that are currently being dispatched                                       
+///   @param type - the type of the event                                     
+///   @return the SDL time of the event, or the current SDL time, if the      
+///      event didn't come with a time, or isn't being dispatched right now   
+Uint64 InputSDL::GetOccurrence(DMeta type) const {
+   const auto found = mOccurred.FindIt(type);
+   return found ? found.GetValue() : SDL_GetTicksNS();
+}
+
+/// Access the input pipeline metrics                                         
+///   @return the metrics                                                     
+InputMetrics& InputSDL::GetMetrics() noexcept {
+   return mMetrics;
+}
+
+/// Access the input pipeline metrics                                         
+///   @return the metrics                                                     
+const InputMetrics& InputSDL::GetMetrics() const noexcept {
+   return mMetrics;
+}
+
+/// Check if a window is already bound to a gatherer                          
+///   @param window - the SDL window identifier                               
+///   @return true if the window is bound                                     
+bool InputSDL::IsBound(SDL_WindowID window) const {
+   return static_cast<bool>(mWindowOwners.FindIt(window));
+}
+
+/// Bind a window to a gatherer, so that all events from that window are      
+/// delivered only to it                                                      
+///   @param window - the SDL window identifier                               
+///   @param gatherer - the gatherer that owns the window                     
+void InputSDL::Bind(SDL_WindowID window, InputGatherer* gatherer) {
+   LANGULUS_ASSERT(not mWindowOwners.FindIt(window), Construct,
+      "Window #", window, " is already owned by another gatherer");
+   mWindowOwners.Insert(window, gatherer);
+   VERBOSE_INPUT("Window #", window, " bound to a gatherer");
+}
+
+/// Unbind a window from its gatherer, its events will be broadcasted again   
+///   @param window - the SDL window identifier                               
+void InputSDL::Unbind(SDL_WindowID window) {
+   mWindowOwners.RemoveKey(window);
+   mWindowEvents.RemoveKey(window);
+   mWindowRepeats.RemoveKey(window);
+}
+
+/// Start reading input directly from a Linux evdev device, bypassing SDL     
+/// Devices are shared between gatherers, and their events are broadcasted    
+///   @param path - path to the device, or to a pipe or recorded stream       
+///   @return the device, or an empty reference if it can't be opened         
+Ref<EvdevDevice> InputSDL::OpenDevice(const Text& path) {
+   const auto found = mDevices.FindIt(path);
+   if (found)
+      return found.GetValue();
+
+   Ref<EvdevDevice> device;
+   device.New(path);
+   if (not device->IsOpen())
+      return {};
+
+   mDevices.Insert(path, device);
+   VERBOSE_INPUT("Reading input directly from ", path);
+   return device;
+}
+
+/// Release a device, and stop reading it if this was its last user           
+///   @param device - [in/out] the device to release, will be reset           
+void InputSDL::CloseDevice(Ref<EvdevDevice>& device) {
+   if (not device)
+      return;
+
+   const auto path = device->GetPath();
+   device.Reset();
+
+   // Only the module's own reference remains                           
+   const auto found = mDevices.FindIt(path);
+   if (found and found.GetValue()->GetReferences() == 1)
+      mDevices.RemoveKey(path);
+}
+
+/// Decide where events from a window should go                               
+///   @param window - the SDL window identifier                               
+///   @return the window if it is owned by a gatherer, or zero if events      
+///      from it should be broadcasted to all gatherers                       
+SDL_WindowID InputSDL::Route(SDL_WindowID window) const {
+   if (window and mWindowOwners.FindIt(window))
+      return window;
+   return 0;
+}
+
+/// Enable or disable mouse motion prediction                                 
+///   @param enable - whether to feed mouse motion to the predictor           
+void InputSDL::EnableMousePrediction(bool enable) {
+   if (enable == mPredictMouse)
+      return;
+
+   mPredictMouse = enable;
+   mMousePredictor.Reset();
+
+   // The predictor needs mouse motion, even if no anticipator does     
+   if (enable)
+      Subscribe(MetaOf<Events::MouseMove>());
+   else
+      Unsubscribe(MetaOf<Events::MouseMove>());
+}
+
+/// Access the mouse motion predictor                                         
+///   @return the predictor                                                   
+const MotionPredictor& InputSDL::GetMousePredictor() const noexcept {
+   return mMousePredictor;
+}
+
+/// Predict the mouse motion between the last sample and a target time,       
+/// so that consumers can hide a frame of latency                             
+///   @param target - the SDL time to predict for, like expected present time 
+///   @return the predicted relative motion, or zero if prediction is off     
+Math::Vec2f InputSDL::PredictMouseDelta(Uint64 target) const noexcept {
+   if (not mPredictMouse)
+      return {};
+   return mMousePredictor.PredictDelta(target);
+}
+
+/// Enable or disable per-frame input snapshots                               
+///   @param depth - number of frames to keep in history, zero to disable     
+void InputSDL::EnableHistory(Count depth) {
+   const bool wasEnabled = mHistory.IsEnabled();
+   mHistory.SetDepth(depth);
+
+   // History needs the whole input stream, regardless of anticipators  
+   if (depth and not wasEnabled)
+      SubscribeAll();
+   else if (not depth and wasEnabled)
+      UnsubscribeAll();
+}
+
+/// Access the input history                                                  
+///   @return the history                                                     
+const InputHistory& InputSDL::GetHistory() const noexcept {
+   return mHistory;
+}
+
+/// Re-inject the input of a historical frame into all gatherers, so that     
+/// it can be re-simulated. The events will be reacted to on next update      
+/// Keys held when the frame began are pressed, and keys that weren't are     
+/// released, so that holds are re-simulated along with the transitions       
+///   @param frame - the absolute frame number, see InputHistory::GetFrame    
+///   @return true if frame was still in history                              
+bool InputSDL::Reinject(uint64_t frame) {
+   InputState state;
+   if (not mHistory.GetState(frame, state))
+      return false;
+
+   const auto transitions = mHistory.Replay(state);
+   for (auto& gatherer : mGatherers) {
+      for (auto transition : transitions) {
+         Event e;
+         e.mType = mHistory.GetKey(transition >> 1);
+         e.mState = transition & 1 ? EventState::End : EventState::Begin;
+         gatherer.PushEvent(e);
+      }
+
+      if (state.mMouse)
+         gatherer.PushEvent(Events::MouseMove {EventState::Point, state.mMouse});
+      if (state.mScroll)
+         gatherer.PushEvent(Events::MouseScroll {EventState::Point, state.mScroll});
+   }
+
+   VERBOSE_INPUT("Re-injected frame #", frame);
+   return true;
+}
+
+/// Subscribe to an event type, enabling the corresponding SDL events if      
+/// this is the first subscriber for their category                           
+///   @param type - the event type to subscribe to                            
+void InputSDL::Subscribe(DMeta type) {
+   const auto category = static_cast<int>(Categorize(type));
+   if (category == static_cast<int>(InputCategory::Counter))
+      return;
+
+   if (mSubscribers[category]++ == 0)
+      Toggle(static_cast<InputCategory>(category), true);
+}
+
+/// Unsubscribe from an event type, disabling the corresponding SDL events    
+/// if this was the last subscriber for their category                        
+///   @param type - the event type to unsubscribe from                        
+void InputSDL::Unsubscribe(DMeta type) {
+   const auto category = static_cast<int>(Categorize(type));
+   if (category == static_cast<int>(InputCategory::Counter))
+      return;
+
+   LANGULUS_ASSUME(DevAssumes, mSubscribers[category] > 0,
+      "Unbalanced input unsubscription");
+   if (--mSubscribers[category] == 0)
+      Toggle(static_cast<InputCategory>(category), false);
+}
+
+/// Get the number of subscriptions to a category of events                   
+///   @param category - the category                                          
+///   @return the number of subscriptions, SDL events of the category are     
+///      enabled only while it's non-zero                                     
+Count InputSDL::GetSubscribers(InputCategory category) const noexcept {
+   return mSubscribers[static_cast<int>(category)];
+}
+
+/// Subscribe to the keyboard, mouse and focus categories at once - used by   
+/// consumers that need the full input stream, regardless of anticipators.    
+/// Motion sensors aren't included, as they would open every gamepad and      
+/// start the gamepad subsystem just for a stream nobody asked for            
+void InputSDL::SubscribeAll() {
+   for (int i = 0; i < static_cast<int>(InputCategory::Sensors); ++i) {
+      if (mSubscribers[i]++ == 0)
+         Toggle(static_cast<InputCategory>(i), true);
+   }
+}
+
+/// Release a subscription made via SubscribeAll()                            
+void InputSDL::UnsubscribeAll() {
+   for (int i = 0; i < static_cast<int>(InputCategory::Sensors); ++i) {
+      LANGULUS_ASSUME(DevAssumes, mSubscribers[i] > 0,
+         "Unbalanced input unsubscription");
+      if (--mSubscribers[i] == 0)
+         Toggle(static_cast<InputCategory>(i), false);
+   }
+}
+
+/// Start delivering key auto-repeats - they're dropped at the source, unless 
+/// there's at least one subscriber                                           
+void InputSDL::SubscribeRepeats() {
+   ++mRepeatSubscribers;
+}
+
+/// Stop delivering key auto-repeats, if this was the last subscriber         
+void InputSDL::UnsubscribeRepeats() {
+   LANGULUS_ASSUME(DevAssumes, mRepeatSubscribers > 0,
+      "Unbalanced repeat unsubscription");
+   --mRepeatSubscribers;
+}
+
+/// Start or stop collecting gamepad motion sensors - the gamepad subsystem   
+/// is started only while somebody anticipates sensor batches                 
+///   @param enable - whether to open or close all gamepads                   
+void InputSDL::EnableSensors(bool enable) {
+   if (enable == mSensors)
+      return;
+
+   if (not enable) {
+      for (auto pair : mSensorDevices)
+         SDL_CloseGamepad(pair.mValue.mGamepad);
+      mSensorDevices.Clear();
+      mSensors = false;
+      Release(SDL_INIT_GAMEPAD);
+      return;
+   }
+
+   if (not Acquire(SDL_INIT_GAMEPAD))
+      return;
+
+   // Open the gamepads that are already connected, the rest will be    
+   // opened as they're added                                           
+   mSensors = true;
+   int count = 0;
+   const auto gamepads = SDL_GetGamepads(&count);
+   for (int i = 0; i < count; ++i)
+      OpenGamepad(gamepads[i]);
+   SDL_free(gamepads);
+}
+
+/// Open a gamepad and enable its motion sensors, if it has any               
+///   @param id - the gamepad to open                                         
+void InputSDL::OpenGamepad(SDL_JoystickID id) {
+   if (not mSensors or mSensorDevices.FindIt(id))
+      return;
+
+   const auto gamepad = SDL_OpenGamepad(id);
+   if (not gamepad) {
+      Logger::Warning(Self(),
+         "SDL failed to open gamepad #", id, ". SDL_Error: ", SDL_GetError());
+      return;
+   }
+
+   bool sensors = false;
+   for (auto sensor : {SDL_SENSOR_GYRO, SDL_SENSOR_ACCEL}) {
+      if (SDL_GamepadHasSensor(gamepad, sensor)
+      and SDL_SetGamepadSensorEnabled(gamepad, sensor, SDL_TRUE) == 0)
+         sensors = true;
+   }
+
+   if (not sensors) {
+      SDL_CloseGamepad(gamepad);
+      return;
+   }
+
+   SensorDevice device;
+   device.mGamepad = gamepad;
+   mSensorDevices.Insert(id, std::move(device));
+   VERBOSE_INPUT("Gamepad #", id, " sensors enabled");
+}
+
+/// Close a gamepad, discarding its undelivered samples                       
+///   @param id - the gamepad to close                                        
+void InputSDL::CloseGamepad(SDL_JoystickID id) {
+   const auto found = mSensorDevices.FindIt(id);
+   if (not found)
+      return;
+
+   SDL_CloseGamepad(found.GetValue().mGamepad);
+   mSensorDevices.RemoveKey(id);
+}
+
+/// Deliver the sensor samples of all gamepads, collected since the last      
+/// poll, as the payload of a single event                                    
+void InputSDL::FlushSensors() {
+   if (not mSensorDevices)
+      return;
+
+   TMany<SensorBatch> batches;
+   for (auto pair : mSensorDevices) {
+      auto& device = pair.mValue;
+      if (not device.mBatch.mGyro.GetCount()
+      and not device.mBatch.mAccel.GetCount())
+         continue;
+
+      device.mBatch.mDevice = pair.mKey;
+      if (mFuseSensors)
+         device.mBatch.mOrientationDelta = device.mFilter.Fuse(device.mBatch);
+      batches << std::move(device.mBatch);
+      device.mBatch = {};
+   }
+
+   if (not batches)
+      return;
+
+   Event newEvent;
+   newEvent.mType = MetaOf<SensorBatch>();
+   newEvent.mState = EventState::Point;
+   newEvent.mPayload = Many {std::move(batches)};
+   PushEvent(newEvent);
+}
+
+/// Enable or disable orientation fusion of gamepad sensors - when enabled,   
+/// each delivered sensor batch carries the rotation of the gamepad since the 
+/// previous batch                                                            
+///   @param enable - whether to fuse gyro and accelerometer samples          
+void InputSDL::EnableSensorFusion(bool enable) {
+   if (enable == mFuseSensors)
+      return;
+
+   // Start from scratch, the orientation is stale by now               
+   for (auto pair : mSensorDevices)
+      pair.mValue.mFilter.Reset();
+   mFuseSensors = enable;
+}
+
+/// Enable or disable all SDL event types of a category                       
+///   @param category - the category to toggle                                
+///   @param enable - whether to enable or disable the category               
+void InputSDL::Toggle(InputCategory category, bool enable) {
+   switch (category) {
+   case InputCategory::Keyboard:
+      SDL_SetEventEnabled(SDL_EVENT_KEY_DOWN, enable);
+      SDL_SetEventEnabled(SDL_EVENT_KEY_UP, enable);
+      break;
+   case InputCategory::MouseButton:
+      SDL_SetEventEnabled(SDL_EVENT_MOUSE_BUTTON_DOWN, enable);
+      SDL_SetEventEnabled(SDL_EVENT_MOUSE_BUTTON_UP, enable);
+      break;
+   case InputCategory::MouseMotion:
+      SDL_SetEventEnabled(SDL_EVENT_MOUSE_MOTION, enable);
+      break;
+   case InputCategory::MouseWheel:
+      SDL_SetEventEnabled(SDL_EVENT_MOUSE_WHEEL, enable);
+      break;
+   case InputCategory::Focus:
+      SDL_SetEventEnabled(SDL_EVENT_WINDOW_FOCUS_GAINED, enable);
+      SDL_SetEventEnabled(SDL_EVENT_WINDOW_FOCUS_LOST, enable);
+      break;
+   case InputCategory::Sensors:
+      SDL_SetEventEnabled(SDL_EVENT_GAMEPAD_ADDED, enable);
+      SDL_SetEventEnabled(SDL_EVENT_GAMEPAD_REMOVED, enable);
+      SDL_SetEventEnabled(SDL_EVENT_GAMEPAD_SENSOR_UPDATE, enable);
+      EnableSensors(enable);
+      break;
+   default:
+      LANGULUS_OOPS(Meta, "Bad input category");
    }
+
+   VERBOSE_INPUT("Input category #", static_cast<int>(category),
+      (enable ? " enabled" : " disabled"));
+}
+
+/// Find out which SDL event category produces a given event type             
+/// Types SDL never produces, like events that other modules interact with,   
+/// have no category - there's nothing to toggle at the source for them       
+///   @param type - the event type                                            
+///   @return the category, or InputCategory::Counter if there's none         
+InputCategory InputSDL::Categorize(DMeta type) {
+   if (not type)
+      return InputCategory::Counter;
+   if (type == MetaOf<Events::MouseMove>())
+      return InputCategory::MouseMotion;
+   if (type == MetaOf<Events::MouseScroll>())
+      return InputCategory::MouseWheel;
+   if (type == MetaOf<Events::WindowFocus>()
+   or  type == MetaOf<Events::WindowUnfocus>())
+      return InputCategory::Focus;
+   if (type == MetaOf<SensorBatch>())
+      return InputCategory::Sensors;
+
+   for (Uint8 button = 0; button < 8; ++button) {
+      if (type == TranslateMouse(button))
+         return InputCategory::MouseButton;
+   }
+
+   // Subscriptions are rare, so keys are simply searched for           
+   for (int code = 0; code <= SDL_SCANCODE_ENDCALL; ++code) {
+      if (type == FindKey(static_cast<SDL_Scancode>(code)))
+         return InputCategory::Keyboard;
+   }
+
+   return InputCategory::Counter;
 }
 
 /// SDL3 keyboard event -> Langulus event translator                          
 ///   @param i - the code to translate                                        
 ///   @return the translated event                                            
 DMeta TranslateKey(SDL_Scancode i) {
+   const auto key = FindKey(i);
+   LANGULUS_ASSERT(key, Meta, "Missing keyboard event");
+   return key;
+}
+
+/// Find the Langulus event of an SDL3 keyboard key, if there is one          
+///   @param i - the code to translate                                        
+///   @return the event, or nullptr if the key has no event yet               
+DMeta FindKey(SDL_Scancode i) {
    switch (i) {
    case SDL_SCANCODE_A:             return MetaOf<Keys::A>();
    case SDL_SCANCODE_B:             return MetaOf<Keys::B>();
@@ -239,7 +1082,7 @@ DMeta TranslateKey(SDL_Scancode i) {
    case SDL_SCANCODE_TAB:           return MetaOf<Keys::Tab>();   
    case SDL_SCANCODE_SPACE:         return MetaOf<Keys::Space>(); 
    case SDL_SCANCODE_MINUS:         return MetaOf<Keys::Minus>(); 
-   case SDL_SCANCODE_EQUALS:        TODO(); return {}; //missing
+   case SDL_SCANCODE_EQUALS:        return {}; //missing
    case SDL_SCANCODE_LEFTBRACKET:   return MetaOf<Keys::LeftBracket>(); 
    case SDL_SCANCODE_RIGHTBRACKET:  return MetaOf<Keys::RightBracket>();
    case SDL_SCANCODE_BACKSLASH:
@@ -299,8 +1142,8 @@ DMeta TranslateKey(SDL_Scancode i) {
    case SDL_SCANCODE_KP_PERIOD:     return MetaOf<Keys::NumpadDecimal>();  
 
    case SDL_SCANCODE_NONUSBACKSLASH:return MetaOf<Keys::Hack>();           
-   case SDL_SCANCODE_APPLICATION:   TODO(); return {}; //missing
-   case SDL_SCANCODE_POWER:         TODO(); return {}; //missing
+   case SDL_SCANCODE_APPLICATION:   return {}; //missing
+   case SDL_SCANCODE_POWER:         return {}; //missing
    case SDL_SCANCODE_KP_EQUALS:     return MetaOf<Keys::NumpadEqual>();    
    case SDL_SCANCODE_F13:           return MetaOf<Keys::F13>();            
    case SDL_SCANCODE_F14:           return MetaOf<Keys::F14>();            
@@ -315,139 +1158,138 @@ DMeta TranslateKey(SDL_Scancode i) {
    case SDL_SCANCODE_F23:           return MetaOf<Keys::F23>();            
    case SDL_SCANCODE_F24:           return MetaOf<Keys::F24>();            
 
-   case SDL_SCANCODE_EXECUTE:       TODO(); return {}; //missing
-   case SDL_SCANCODE_HELP:          TODO(); return {}; //missing
-   case SDL_SCANCODE_MENU:          TODO(); return {}; //missing
-   case SDL_SCANCODE_SELECT:        TODO(); return {}; //missing
-   case SDL_SCANCODE_STOP:          TODO(); return {}; //missing
-   case SDL_SCANCODE_AGAIN:         TODO(); return {}; //missing
-   case SDL_SCANCODE_UNDO:          TODO(); return {}; //missing
-   case SDL_SCANCODE_CUT:           TODO(); return {}; //missing
-   case SDL_SCANCODE_COPY:          TODO(); return {}; //missing
-   case SDL_SCANCODE_PASTE:         TODO(); return {}; //missing
-   case SDL_SCANCODE_FIND:          TODO(); return {}; //missing
-   case SDL_SCANCODE_MUTE:          TODO(); return {}; //missing
-   case SDL_SCANCODE_VOLUMEUP:      TODO(); return {}; //missing
-   case SDL_SCANCODE_VOLUMEDOWN:    TODO(); return {}; //missing
-   case SDL_SCANCODE_KP_COMMA:      TODO(); return {}; //missing
-   case SDL_SCANCODE_KP_EQUALSAS400:TODO(); return {}; //missing
-
-   case SDL_SCANCODE_INTERNATIONAL1:TODO(); return {}; /**< used on Asian keyboards, see footnotes in USB doc */
-   case SDL_SCANCODE_INTERNATIONAL2:TODO(); return {}; 
-   case SDL_SCANCODE_INTERNATIONAL3:TODO(); return {}; /**< Yen */
-   case SDL_SCANCODE_INTERNATIONAL4:TODO(); return {}; 
-   case SDL_SCANCODE_INTERNATIONAL5:TODO(); return {}; 
-   case SDL_SCANCODE_INTERNATIONAL6:TODO(); return {}; 
-   case SDL_SCANCODE_INTERNATIONAL7:TODO(); return {}; 
-   case SDL_SCANCODE_INTERNATIONAL8:TODO(); return {}; 
-   case SDL_SCANCODE_INTERNATIONAL9:TODO(); return {}; 
-
-   case SDL_SCANCODE_LANG1:         TODO(); return {}; /**< Hangul/English toggle */
-   case SDL_SCANCODE_LANG2:         TODO(); return {}; /**< Hanja conversion */
-   case SDL_SCANCODE_LANG3:         TODO(); return {}; /**< Katakana */
-   case SDL_SCANCODE_LANG4:         TODO(); return {}; /**< Hiragana */
-   case SDL_SCANCODE_LANG5:         TODO(); return {}; /**< Zenkaku/Hankaku */
-   case SDL_SCANCODE_LANG6:         TODO(); return {}; /**< reserved */
-   case SDL_SCANCODE_LANG7:         TODO(); return {}; /**< reserved */
-   case SDL_SCANCODE_LANG8:         TODO(); return {}; /**< reserved */
-   case SDL_SCANCODE_LANG9:         TODO(); return {}; /**< reserved */
-
-   case SDL_SCANCODE_ALTERASE:      TODO(); return {}; /**< Erase-Eaze */
-   case SDL_SCANCODE_SYSREQ:        TODO(); return {}; 
-   case SDL_SCANCODE_CANCEL:        TODO(); return {}; /**< AC Cancel */
-   case SDL_SCANCODE_CLEAR:         TODO(); return {}; 
-   case SDL_SCANCODE_PRIOR:         TODO(); return {}; 
-   case SDL_SCANCODE_RETURN2:       TODO(); return {}; 
-   case SDL_SCANCODE_SEPARATOR:     TODO(); return {}; 
-   case SDL_SCANCODE_OUT:           TODO(); return {}; 
-   case SDL_SCANCODE_OPER:          TODO(); return {}; 
-   case SDL_SCANCODE_CLEARAGAIN:    TODO(); return {}; 
-   case SDL_SCANCODE_CRSEL:         TODO(); return {}; 
-   case SDL_SCANCODE_EXSEL:         TODO(); return {}; 
-
-   case SDL_SCANCODE_KP_00:               TODO(); return {}; 
-   case SDL_SCANCODE_KP_000:              TODO(); return {}; 
-   case SDL_SCANCODE_THOUSANDSSEPARATOR:  TODO(); return {}; 
-   case SDL_SCANCODE_DECIMALSEPARATOR:    TODO(); return {}; 
-   case SDL_SCANCODE_CURRENCYUNIT:        TODO(); return {}; 
-   case SDL_SCANCODE_CURRENCYSUBUNIT:     TODO(); return {}; 
-   case SDL_SCANCODE_KP_LEFTPAREN:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_RIGHTPAREN:       TODO(); return {}; 
-   case SDL_SCANCODE_KP_LEFTBRACE:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_RIGHTBRACE:       TODO(); return {}; 
-   case SDL_SCANCODE_KP_TAB:              TODO(); return {}; 
-   case SDL_SCANCODE_KP_BACKSPACE:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_A:                TODO(); return {}; 
-   case SDL_SCANCODE_KP_B:                TODO(); return {}; 
-   case SDL_SCANCODE_KP_C:                TODO(); return {}; 
-   case SDL_SCANCODE_KP_D:                TODO(); return {}; 
-   case SDL_SCANCODE_KP_E:                TODO(); return {}; 
-   case SDL_SCANCODE_KP_F:                TODO(); return {}; 
-   case SDL_SCANCODE_KP_XOR:              TODO(); return {}; 
-   case SDL_SCANCODE_KP_POWER:            TODO(); return {}; 
-   case SDL_SCANCODE_KP_PERCENT:          TODO(); return {}; 
-   case SDL_SCANCODE_KP_LESS:             TODO(); return {}; 
-   case SDL_SCANCODE_KP_GREATER:          TODO(); return {}; 
-   case SDL_SCANCODE_KP_AMPERSAND:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_DBLAMPERSAND:     TODO(); return {}; 
-   case SDL_SCANCODE_KP_VERTICALBAR:      TODO(); return {}; 
-   case SDL_SCANCODE_KP_DBLVERTICALBAR:   TODO(); return {}; 
-   case SDL_SCANCODE_KP_COLON:            TODO(); return {}; 
-   case SDL_SCANCODE_KP_HASH:             TODO(); return {}; 
-   case SDL_SCANCODE_KP_SPACE:            TODO(); return {}; 
-   case SDL_SCANCODE_KP_AT:               TODO(); return {}; 
-   case SDL_SCANCODE_KP_EXCLAM:           TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMSTORE:         TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMRECALL:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMCLEAR:         TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMADD:           TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMSUBTRACT:      TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMMULTIPLY:      TODO(); return {}; 
-   case SDL_SCANCODE_KP_MEMDIVIDE:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_PLUSMINUS:        TODO(); return {}; 
-   case SDL_SCANCODE_KP_CLEAR:            TODO(); return {}; 
-   case SDL_SCANCODE_KP_CLEARENTRY:       TODO(); return {}; 
-   case SDL_SCANCODE_KP_BINARY:           TODO(); return {}; 
-   case SDL_SCANCODE_KP_OCTAL:            TODO(); return {}; 
-   case SDL_SCANCODE_KP_DECIMAL:          TODO(); return {}; 
-   case SDL_SCANCODE_KP_HEXADECIMAL:      TODO(); return {}; 
+   case SDL_SCANCODE_EXECUTE:       return {}; //missing
+   case SDL_SCANCODE_HELP:          return {}; //missing
+   case SDL_SCANCODE_MENU:          return {}; //missing
+   case SDL_SCANCODE_SELECT:        return {}; //missing
+   case SDL_SCANCODE_STOP:          return {}; //missing
+   case SDL_SCANCODE_AGAIN:         return {}; //missing
+   case SDL_SCANCODE_UNDO:          return {}; //missing
+   case SDL_SCANCODE_CUT:           return {}; //missing
+   case SDL_SCANCODE_COPY:          return {}; //missing
+   case SDL_SCANCODE_PASTE:         return {}; //missing
+   case SDL_SCANCODE_FIND:          return {}; //missing
+   case SDL_SCANCODE_MUTE:          return {}; //missing
+   case SDL_SCANCODE_VOLUMEUP:      return {}; //missing
+   case SDL_SCANCODE_VOLUMEDOWN:    return {}; //missing
+   case SDL_SCANCODE_KP_COMMA:      return {}; //missing
+   case SDL_SCANCODE_KP_EQUALSAS400:return {}; //missing
+
+   case SDL_SCANCODE_INTERNATIONAL1:return {}; /**< used on Asian keyboards, see footnotes in USB doc */
+   case SDL_SCANCODE_INTERNATIONAL2:return {}; 
+   case SDL_SCANCODE_INTERNATIONAL3:return {}; /**< Yen */
+   case SDL_SCANCODE_INTERNATIONAL4:return {}; 
+   case SDL_SCANCODE_INTERNATIONAL5:return {}; 
+   case SDL_SCANCODE_INTERNATIONAL6:return {}; 
+   case SDL_SCANCODE_INTERNATIONAL7:return {}; 
+   case SDL_SCANCODE_INTERNATIONAL8:return {}; 
+   case SDL_SCANCODE_INTERNATIONAL9:return {}; 
+
+   case SDL_SCANCODE_LANG1:         return {}; /**< Hangul/English toggle */
+   case SDL_SCANCODE_LANG2:         return {}; /**< Hanja conversion */
+   case SDL_SCANCODE_LANG3:         return {}; /**< Katakana */
+   case SDL_SCANCODE_LANG4:         return {}; /**< Hiragana */
+   case SDL_SCANCODE_LANG5:         return {}; /**< Zenkaku/Hankaku */
+   case SDL_SCANCODE_LANG6:         return {}; /**< reserved */
+   case SDL_SCANCODE_LANG7:         return {}; /**< reserved */
+   case SDL_SCANCODE_LANG8:         return {}; /**< reserved */
+   case SDL_SCANCODE_LANG9:         return {}; /**< reserved */
+
+   case SDL_SCANCODE_ALTERASE:      return {}; /**< Erase-Eaze */
+   case SDL_SCANCODE_SYSREQ:        return {}; 
+   case SDL_SCANCODE_CANCEL:        return {}; /**< AC Cancel */
+   case SDL_SCANCODE_CLEAR:         return {}; 
+   case SDL_SCANCODE_PRIOR:         return {}; 
+   case SDL_SCANCODE_RETURN2:       return {}; 
+   case SDL_SCANCODE_SEPARATOR:     return {}; 
+   case SDL_SCANCODE_OUT:           return {}; 
+   case SDL_SCANCODE_OPER:          return {}; 
+   case SDL_SCANCODE_CLEARAGAIN:    return {}; 
+   case SDL_SCANCODE_CRSEL:         return {}; 
+   case SDL_SCANCODE_EXSEL:         return {}; 
+
+   case SDL_SCANCODE_KP_00:               return {}; 
+   case SDL_SCANCODE_KP_000:              return {}; 
+   case SDL_SCANCODE_THOUSANDSSEPARATOR:  return {}; 
+   case SDL_SCANCODE_DECIMALSEPARATOR:    return {}; 
+   case SDL_SCANCODE_CURRENCYUNIT:        return {}; 
+   case SDL_SCANCODE_CURRENCYSUBUNIT:     return {}; 
+   case SDL_SCANCODE_KP_LEFTPAREN:        return {}; 
+   case SDL_SCANCODE_KP_RIGHTPAREN:       return {}; 
+   case SDL_SCANCODE_KP_LEFTBRACE:        return {}; 
+   case SDL_SCANCODE_KP_RIGHTBRACE:       return {}; 
+   case SDL_SCANCODE_KP_TAB:              return {}; 
+   case SDL_SCANCODE_KP_BACKSPACE:        return {}; 
+   case SDL_SCANCODE_KP_A:                return {}; 
+   case SDL_SCANCODE_KP_B:                return {}; 
+   case SDL_SCANCODE_KP_C:                return {}; 
+   case SDL_SCANCODE_KP_D:                return {}; 
+   case SDL_SCANCODE_KP_E:                return {}; 
+   case SDL_SCANCODE_KP_F:                return {}; 
+   case SDL_SCANCODE_KP_XOR:              return {}; 
+   case SDL_SCANCODE_KP_POWER:            return {}; 
+   case SDL_SCANCODE_KP_PERCENT:          return {}; 
+   case SDL_SCANCODE_KP_LESS:             return {}; 
+   case SDL_SCANCODE_KP_GREATER:          return {}; 
+   case SDL_SCANCODE_KP_AMPERSAND:        return {}; 
+   case SDL_SCANCODE_KP_DBLAMPERSAND:     return {}; 
+   case SDL_SCANCODE_KP_VERTICALBAR:      return {}; 
+   case SDL_SCANCODE_KP_DBLVERTICALBAR:   return {}; 
+   case SDL_SCANCODE_KP_COLON:            return {}; 
+   case SDL_SCANCODE_KP_HASH:             return {}; 
+   case SDL_SCANCODE_KP_SPACE:            return {}; 
+   case SDL_SCANCODE_KP_AT:               return {}; 
+   case SDL_SCANCODE_KP_EXCLAM:           return {}; 
+   case SDL_SCANCODE_KP_MEMSTORE:         return {}; 
+   case SDL_SCANCODE_KP_MEMRECALL:        return {}; 
+   case SDL_SCANCODE_KP_MEMCLEAR:         return {}; 
+   case SDL_SCANCODE_KP_MEMADD:           return {}; 
+   case SDL_SCANCODE_KP_MEMSUBTRACT:      return {}; 
+   case SDL_SCANCODE_KP_MEMMULTIPLY:      return {}; 
+   case SDL_SCANCODE_KP_MEMDIVIDE:        return {}; 
+   case SDL_SCANCODE_KP_PLUSMINUS:        return {}; 
+   case SDL_SCANCODE_KP_CLEAR:            return {}; 
+   case SDL_SCANCODE_KP_CLEARENTRY:       return {}; 
+   case SDL_SCANCODE_KP_BINARY:           return {}; 
+   case SDL_SCANCODE_KP_OCTAL:            return {}; 
+   case SDL_SCANCODE_KP_DECIMAL:          return {}; 
+   case SDL_SCANCODE_KP_HEXADECIMAL:      return {}; 
 
    case SDL_SCANCODE_LCTRL:            return MetaOf<Keys::LeftControl>(); 
    case SDL_SCANCODE_LSHIFT:           return MetaOf<Keys::LeftShift>();   
    case SDL_SCANCODE_LALT:             return MetaOf<Keys::LeftAlt>();     
-   case SDL_SCANCODE_LGUI:             TODO(); return {}; //missing
+   case SDL_SCANCODE_LGUI:             return {}; //missing
    case SDL_SCANCODE_RCTRL:            return MetaOf<Keys::RightControl>();
    case SDL_SCANCODE_RSHIFT:           return MetaOf<Keys::RightShift>();  
    case SDL_SCANCODE_RALT:             return MetaOf<Keys::RightAlt>();    
-   case SDL_SCANCODE_RGUI:             TODO(); return {}; //missing
-
-   case SDL_SCANCODE_MODE:             TODO(); return {}; //missing
-
-   case SDL_SCANCODE_MEDIA_NEXT_TRACK:       TODO(); return {}; // missing
-   case SDL_SCANCODE_MEDIA_PREVIOUS_TRACK:   TODO(); return {}; // missing
-   case SDL_SCANCODE_MEDIA_STOP:             TODO(); return {}; // missing
-   case SDL_SCANCODE_MEDIA_PLAY:             TODO(); return {}; // missing
-   case SDL_SCANCODE_MEDIA_SELECT:           TODO(); return {}; // missing
-   case SDL_SCANCODE_MEDIA_REWIND:           TODO(); return {}; // missing
-   case SDL_SCANCODE_MEDIA_FAST_FORWARD:     TODO(); return {}; // missing
-
-   case SDL_SCANCODE_AC_SEARCH:              TODO(); return {}; // missing
-   case SDL_SCANCODE_AC_HOME:                TODO(); return {}; // missing
-   case SDL_SCANCODE_AC_BACK:                TODO(); return {}; // missing
-   case SDL_SCANCODE_AC_FORWARD:             TODO(); return {}; // missing
-   case SDL_SCANCODE_AC_STOP:                TODO(); return {}; // missing
-   case SDL_SCANCODE_AC_REFRESH:             TODO(); return {}; // missing
-   case SDL_SCANCODE_AC_BOOKMARKS:           TODO(); return {}; // missing
-
-   case SDL_SCANCODE_MEDIA_EJECT:            TODO(); return {}; // missing
-   case SDL_SCANCODE_SLEEP:                  TODO(); return {}; // missing
-
-   case SDL_SCANCODE_SOFTLEFT:               TODO(); return {}; // missing
-   case SDL_SCANCODE_SOFTRIGHT:              TODO(); return {}; // missing
-   case SDL_SCANCODE_CALL:                   TODO(); return {}; // missing
-   case SDL_SCANCODE_ENDCALL:                TODO(); return {}; // missing
+   case SDL_SCANCODE_RGUI:             return {}; //missing
+
+   case SDL_SCANCODE_MODE:             return {}; //missing
+
+   case SDL_SCANCODE_MEDIA_NEXT_TRACK:       return {}; // missing
+   case SDL_SCANCODE_MEDIA_PREVIOUS_TRACK:   return {}; // missing
+   case SDL_SCANCODE_MEDIA_STOP:             return {}; // missing
+   case SDL_SCANCODE_MEDIA_PLAY:             return {}; // missing
+   case SDL_SCANCODE_MEDIA_SELECT:           return {}; // missing
+   case SDL_SCANCODE_MEDIA_REWIND:           return {}; // missing
+   case SDL_SCANCODE_MEDIA_FAST_FORWARD:     return {}; // missing
+
+   case SDL_SCANCODE_AC_SEARCH:              return {}; // missing
+   case SDL_SCANCODE_AC_HOME:                return {}; // missing
+   case SDL_SCANCODE_AC_BACK:                return {}; // missing
+   case SDL_SCANCODE_AC_FORWARD:             return {}; // missing
+   case SDL_SCANCODE_AC_STOP:                return {}; // missing
+   case SDL_SCANCODE_AC_REFRESH:             return {}; // missing
+   case SDL_SCANCODE_AC_BOOKMARKS:           return {}; // missing
+
+   case SDL_SCANCODE_MEDIA_EJECT:            return {}; // missing
+   case SDL_SCANCODE_SLEEP:                  return {}; // missing
+
+   case SDL_SCANCODE_SOFTLEFT:               return {}; // missing
+   case SDL_SCANCODE_SOFTRIGHT:              return {}; // missing
+   case SDL_SCANCODE_CALL:                   return {}; // missing
+   case SDL_SCANCODE_ENDCALL:                return {}; // missing
    default:
-      LANGULUS_OOPS(Meta, "Missing keyboard event");
       return {};
    }
 }
@@ -7,9 +7,36 @@
 ///                                                                           
 #pragma once
 #include "InputGatherer.hpp"
+#include "InputMetrics.hpp"
+#include "MotionPredictor.hpp"
+#include "InputHistory.hpp"
+#include "Evdev.hpp"
+#include "Sensors.hpp"
 #include <Langulus/Verbs/Create.hpp>
 
 
+///                                                                           
+///   Categories of SDL events, that can be toggled at the source             
+///                                                                           
+/// Each category maps to one or more SDL event types, that get disabled via  
+/// SDL_SetEventEnabled while nobody is subscribed to them                    
+///                                                                           
+enum class InputCategory : uint8_t {
+   Keyboard,
+   MouseButton,
+   MouseMotion,
+   MouseWheel,
+   Focus,
+
+   // Categories below aren't part of the stream SubscribeAll() covers, 
+   // since they acquire extra devices and subsystems                   
+   Sensors,
+
+   // Number of categories - also stands for types SDL never produces   
+   Counter
+};
+
+
 ///                                                                           
 ///   Raw input module using SDL                                              
 ///                                                                           
@@ -24,8 +51,83 @@ private:
    // List of created input gatherers                                   
    TFactory<InputGatherer> mGatherers;
 
-   // Global list of events                                             
+   // Global list of events, broadcasted to all gatherers               
    EventList mGlobalEvents;
+   // Key auto-repeats, as Point events, broadcasted to all gatherers   
+   EventList mRepeats;
+   // Number of anticipators that react on key auto-repeats             
+   Count mRepeatSubscribers = 0;
+   // Events that occured in windows owned by specific gatherers        
+   TUnorderedMap<SDL_WindowID, EventList> mWindowEvents;
+   // Key auto-repeats that occured in windows owned by gatherers       
+   TUnorderedMap<SDL_WindowID, EventList> mWindowRepeats;
+   // Gatherers that own windows                                        
+   TUnorderedMap<SDL_WindowID, InputGatherer*> mWindowOwners;
+
+   // Accumulated mouse movement and scroll per routed window           
+   TUnorderedMap<SDL_WindowID, Math::Vec2f> mMouseMovement;
+   TUnorderedMap<SDL_WindowID, Math::Vec2f> mMouseScroll;
+
+   // Number of subscribers for each category of SDL events             
+   Count mSubscribers[static_cast<int>(InputCategory::Counter)] {};
+
+   // Number of users of each SDL subsystem, started on demand          
+   TUnorderedMap<Uint32, Count> mSubsystems;
+
+   // Set when SDL reports a quit request during a late sample          
+   bool mQuitRequested = false;
+
+   // If non-zero, Update blocks for up to this many milliseconds,      
+   // waiting for input, whenever there's no pending work               
+   Sint32 mIdleTimeout = 0;
+   // While devices are read directly, idle mode checks SDL this often, 
+   // in milliseconds - the worst latency idle mode adds to SDL input   
+   static constexpr Uint64 IdleSlice = 1;
+
+   // Pipeline counters and timings                                     
+   InputMetrics mMetrics;
+   // SDL time of the latest event of each type, polled since the last  
+   // dispatch - anticipator policies measure the time between events,  
+   // not between the updates that happen to dispatch them              
+   TUnorderedMap<DMeta, Uint64> mOccurred;
+
+   // Opt-in mouse motion prediction                                    
+   bool mPredictMouse = false;
+   MotionPredictor mMousePredictor;
+
+   // Opt-in per-frame input snapshots for rollback                     
+   InputHistory mHistory;
+
+   // Linux input devices read directly, bypassing SDL and the desktop  
+   EvdevDevices mDevices;
+
+   // A gamepad opened for its motion sensors, and its samples, that are
+   // collected during the frame and delivered as a single batch        
+   struct SensorDevice {
+      SDL_Gamepad* mGamepad {};
+      SensorBatch mBatch;
+      OrientationFilter mFilter;
+   };
+
+   // Whether gamepad sensors are enabled, and the opened gamepads      
+   bool mSensors = false;
+   TUnorderedMap<SDL_JoystickID, SensorDevice> mSensorDevices;
+   // Opt-in orientation fusion of gyro and accelerometer samples       
+   bool mFuseSensors = false;
+
+   bool Idle();
+   bool Poll();
+   bool Translate(const SDL_Event&);
+   void Toggle(InputCategory, bool);
+   static InputCategory Categorize(DMeta);
+   bool Merge(EventList&, const Event&);
+   void Occurred(DMeta, Uint64);
+   SDL_WindowID Route(SDL_WindowID) const;
+   void Accumulate(TUnorderedMap<SDL_WindowID, Math::Vec2f>&, SDL_WindowID, const Math::Vec2f&);
+   void EnableSensors(bool);
+   void OpenGamepad(SDL_JoystickID);
+   void CloseGamepad(SDL_JoystickID);
+   void FlushSensors();
 
 public:
     InputSDL(Runtime*, const Many&);
@@ -34,6 +136,44 @@ public:
    void Create(Verb&);
 
    bool Update(Time);
-   void PushEvent(const Event&);
+   bool Sample();
+   bool HasPendingWork() const;
+   void SetIdleTimeout(Time);
+   void PushEvent(const Event&, SDL_WindowID = 0, Uint64 = 0);
+   void Move(SDL_WindowID, const Math::Vec2f&, Uint64);
+   void Scroll(SDL_WindowID, const Math::Vec2f&, Uint64);
    void Teardown();
+
+   bool Acquire(Uint32);
+   void Release(Uint32);
+   Count GetSubsystemUsers(Uint32) const noexcept;
+
+   bool IsBound(SDL_WindowID) const;
+   void Bind(SDL_WindowID, InputGatherer*);
+   void Unbind(SDL_WindowID);
+
+   Ref<EvdevDevice> OpenDevice(const Text&);
+   void CloseDevice(Ref<EvdevDevice>&);
+
+   void Subscribe(DMeta);
+   void Unsubscribe(DMeta);
+   Count GetSubscribers(InputCategory) const noexcept;
+   void SubscribeAll();
+   void UnsubscribeAll();
+   void SubscribeRepeats();
+   void UnsubscribeRepeats();
+
+   Uint64 GetOccurrence(DMeta) const;
+   InputMetrics& GetMetrics() noexcept;
+   const InputMetrics& GetMetrics() const noexcept;
+
+   void EnableMousePrediction(bool);
+   const MotionPredictor& GetMousePredictor() const noexcept;
+   Math::Vec2f PredictMouseDelta(Uint64) const noexcept;
+
+   void EnableSensorFusion(bool);
+
+   void EnableHistory(Count);
+   const InputHistory& GetHistory() const noexcept;
+   bool Reinject(uint64_t);
 };
\ No newline at end of file
@@ -0,0 +1,19 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "InputSDL.hpp"
+
+/// The module's entry point is kept apart from the rest of the sources, that 
+/// are built into an internal library - only the module itself defines it    
+LANGULUS_DEFINE_MODULE(
+   InputSDL, 0, "InputSDL",
+   "Raw input module, using SDL as backend - "
+   "allows for raw mouse/joystick/keyboard inputs even on console applications, "
+   "by using an external window", "",
+   InputSDL, InputGatherer, InputListener, Anticipator, InputWindow,
+   AnticipatorPolicy, ListenerPolicy, InputDevice, InputIdle, SensorBatch
+)
@@ -0,0 +1,131 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "MotionPredictor.hpp"
+#include <cmath>
+
+
+/// Feed a motion sample to the predictor                                     
+///   @param timestamp - the SDL timestamp of the sample                      
+///   @param delta - the relative motion                                      
+void MotionPredictor::Sample(Uint64 timestamp, const Math::Vec2f& delta) {
+   mPosition.x += delta.x;
+   mPosition.y += delta.y;
+
+   // Samples that arrive with the same timestamp have no time span of  
+   // their own - keep them for the next sample that has one            
+   if (mSamples and timestamp <= mTimestamp) {
+      mPending.x += delta.x;
+      mPending.y += delta.y;
+      return;
+   }
+
+   if (not mSamples or timestamp - mTimestamp > StaleAfter) {
+      // First sample after a stop - we can't estimate velocity yet     
+      mVelocity = {};
+      mAcceleration = {};
+      mPending = {};
+      mTimestamp = timestamp;
+      mSamples = 1;
+      return;
+   }
+
+   const float dt = (timestamp - mTimestamp) * 1e-9f;
+   const float vx = (delta.x + mPending.x) / dt;
+   const float vy = (delta.y + mPending.y) / dt;
+   mPending = {};
+   mTimestamp = timestamp;
+
+   if (mSamples == 1) {
+      // First velocity since a stop - take it as it is, since there's  
+      // no previous estimate to smooth it with                         
+      mVelocity = {vx, vy};
+      mSamples = 2;
+      return;
+   }
+
+   if (vx * mVelocity.x + vy * mVelocity.y < 0) {
+      // Direction reversed - previous estimate is useless              
+      mVelocity = {vx, vy};
+      mAcceleration = {};
+      mSamples = 2;
+      return;
+   }
+
+   const float nvx = mVelocity.x + (vx - mVelocity.x) * VelocitySmoothing;
+   const float nvy = mVelocity.y + (vy - mVelocity.y) * VelocitySmoothing;
+   if (mSamples > 1) {
+      mAcceleration.x += ((nvx - mVelocity.x) / dt - mAcceleration.x) * AccelerationSmoothing;
+      mAcceleration.y += ((nvy - mVelocity.y) / dt - mAcceleration.y) * AccelerationSmoothing;
+   }
+
+   mVelocity = {nvx, nvy};
+   ++mSamples;
+}
+
+/// Forget all estimates                                                      
+void MotionPredictor::Reset() noexcept {
+   mPosition = {};
+   mVelocity = {};
+   mAcceleration = {};
+   mPending = {};
+   mTimestamp = 0;
+   mSamples = 0;
+}
+
+/// Extrapolate the motion that will occur between the last sample and a      
+/// target time. The result is bounded to twice the distance the current      
+/// velocity would travel, and never points against the current velocity      
+///   @param target - the SDL time to predict for, like expected present time 
+///   @return the predicted relative motion since the last sample             
+Math::Vec2f MotionPredictor::PredictDelta(Uint64 target) const noexcept {
+   if (mSamples < 2 or target <= mTimestamp
+   or  target - mTimestamp > StaleAfter)
+      return {};
+
+   const auto horizon = target - mTimestamp < MaxHorizon
+      ? target - mTimestamp : MaxHorizon;
+   const float h = horizon * 1e-9f;
+   const float linearX = mVelocity.x * h;
+   const float linearY = mVelocity.y * h;
+   float x = linearX + 0.5f * mAcceleration.x * h * h;
+   float y = linearY + 0.5f * mAcceleration.y * h * h;
+
+   // Deceleration may stop the motion, but never reverse it            
+   if (x * linearX + y * linearY <= 0)
+      return {};
+
+   // Acceleration may at most double the linear extrapolation          
+   const float linear = std::sqrt(linearX * linearX + linearY * linearY);
+   const float predicted = std::sqrt(x * x + y * y);
+   if (predicted > 2 * linear) {
+      x *= 2 * linear / predicted;
+      y *= 2 * linear / predicted;
+   }
+
+   return {x, y};
+}
+
+/// Extrapolate the accumulated position to a target time                     
+///   @param target - the SDL time to predict for, like expected present time 
+///   @return the predicted position                                          
+Math::Vec2f MotionPredictor::PredictPosition(Uint64 target) const noexcept {
+   const auto delta = PredictDelta(target);
+   return {mPosition.x + delta.x, mPosition.y + delta.y};
+}
+
+/// Get the sum of all sampled deltas                                         
+///   @return the position                                                    
+const Math::Vec2f& MotionPredictor::GetPosition() const noexcept {
+   return mPosition;
+}
+
+/// Get the estimated velocity                                                
+///   @return the velocity, in units per second                               
+const Math::Vec2f& MotionPredictor::GetVelocity() const noexcept {
+   return mVelocity;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+
+///                                                                           
+///   Motion predictor                                                        
+///                                                                           
+/// Estimates velocity and acceleration of a two-dimensional relative motion  
+/// (mouse, analog sticks) from timestamped samples, and extrapolates it to   
+/// a future point in time, in order to hide input latency. Extrapolation is  
+/// limited in time and magnitude, never reverses the observed direction,     
+/// and the estimate is reset whenever the motion reverses or stops.          
+/// All timestamps are in nanoseconds, as reported by SDL_GetTicksNS          
+///                                                                           
+struct MotionPredictor {
+   // Never extrapolate further than this into the future               
+   static constexpr Uint64 MaxHorizon = 50'000'000;
+   // Samples older than this are considered a stop in motion           
+   static constexpr Uint64 StaleAfter = 100'000'000;
+   // Smoothing factors for velocity and acceleration estimates         
+   static constexpr float VelocitySmoothing = 0.6f;
+   static constexpr float AccelerationSmoothing = 0.3f;
+
+private:
+   // Sum of all sampled deltas                                         
+   Math::Vec2f mPosition;
+   // Estimated velocity, in units per second                           
+   Math::Vec2f mVelocity;
+   // Estimated acceleration, in units per second squared               
+   Math::Vec2f mAcceleration;
+   // Timestamp of the last sample                                      
+   Uint64 mTimestamp = 0;
+   // Deltas that arrived with the timestamp of the last sample - they  
+   // are folded into the next velocity estimate                        
+   Math::Vec2f mPending;
+   // Number of samples since last reset                                
+   Count mSamples = 0;
+
+public:
+   void Sample(Uint64, const Math::Vec2f&);
+   void Reset() noexcept;
+
+   Math::Vec2f PredictDelta(Uint64) const noexcept;
+   Math::Vec2f PredictPosition(Uint64) const noexcept;
+
+   const Math::Vec2f& GetPosition() const noexcept;
+   const Math::Vec2f& GetVelocity() const noexcept;
+};
\ No newline at end of file
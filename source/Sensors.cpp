@@ -0,0 +1,185 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Sensors.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+/// Push a sample to the stream                                               
+///   @param timestamp - time of the sample, in nanoseconds                   
+///   @param data - the three components of the sample                        
+void SensorStream::Push(Uint64 timestamp, const float* data) {
+   mTimestamps << timestamp;
+   mX << data[0];
+   mY << data[1];
+   mZ << data[2];
+}
+
+/// Get the number of samples in the stream                                   
+///   @return the number of samples                                           
+Count SensorStream::GetCount() const noexcept {
+   return mTimestamps.GetCount();
+}
+
+/// Multiply two quaternions (x, y, z, w)                                     
+///   @param a - left quaternion                                              
+///   @param b - right quaternion                                             
+///   @param out - where to write a * b, can't alias the arguments            
+static void Multiply(const float* a, const float* b, float* out) noexcept {
+   out[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+   out[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+   out[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+   out[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+}
+
+/// Normalize a quaternion in place                                           
+///   @param q - the quaternion (x, y, z, w)                                  
+static void Normalize(float* q) noexcept {
+   const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+   if (length <= 0) {
+      q[0] = q[1] = q[2] = 0;
+      q[3] = 1;
+      return;
+   }
+
+   for (int i = 0; i < 4; ++i)
+      q[i] /= length;
+}
+
+/// Rotate a vector by a unit quaternion                                      
+///   @param q - the quaternion (x, y, z, w)                                  
+///   @param v - the vector to rotate in place                                
+static void Rotate(const float* q, float* v) noexcept {
+   // v' = v + 2w(u x v) + 2u x (u x v), where u is the vector part     
+   const float t[3] {
+      2 * (q[1] * v[2] - q[2] * v[1]),
+      2 * (q[2] * v[0] - q[0] * v[2]),
+      2 * (q[0] * v[1] - q[1] * v[0])
+   };
+
+   const float v0 = v[0] + q[3] * t[0] + q[1] * t[2] - q[2] * t[1];
+   const float v1 = v[1] + q[3] * t[1] + q[2] * t[0] - q[0] * t[2];
+   const float v2 = v[2] + q[3] * t[2] + q[0] * t[1] - q[1] * t[0];
+   v[0] = v0;
+   v[1] = v1;
+   v[2] = v2;
+}
+
+/// Fuse a batch of samples into the orientation                              
+/// The per-sample work is done in chunks over the packed arrays, in loops    
+/// without dependencies that compilers vectorize, leaving only the chain of  
+/// small quaternion products sequential                                      
+///   @param batch - the samples of the frame                                 
+///   @return the rotation since the previous batch, as a quaternion          
+///      (x, y, z, w) in the gamepad's local frame                            
+Math::Vec4f OrientationFilter::Fuse(const SensorBatch& batch) {
+   const float previous[4] {
+      mOrientation[0], mOrientation[1], mOrientation[2], mOrientation[3]
+   };
+
+   // Integrate the gyro                                                
+   static constexpr Count Chunk = 64;
+   const auto samples = batch.mGyro.GetCount();
+   const auto timestamps = batch.mGyro.mTimestamps.GetRaw();
+   const auto gx = batch.mGyro.mX.GetRaw();
+   const auto gy = batch.mGyro.mY.GetRaw();
+   const auto gz = batch.mGyro.mZ.GetRaw();
+   float elapsed = 0;
+
+   for (Offset start = 0; start < samples; start += Chunk) {
+      const auto count = std::min(Chunk, samples - start);
+      float step[Chunk];
+      float hx[Chunk], hy[Chunk], hz[Chunk];
+
+      // Time steps, the first sample after a reset has none            
+      // Out of order samples get a negative step, that's clamped       
+      step[0] = mTimestamp
+         ? static_cast<Sint64>(timestamps[start] - mTimestamp) * 1e-9f : 0;
+      for (Offset i = 1; i < count; ++i) {
+         step[i] = static_cast<Sint64>(
+            timestamps[start + i] - timestamps[start + i - 1]) * 1e-9f;
+      }
+      mTimestamp = timestamps[start + count - 1];
+
+      // Half-angle rotations around each axis                          
+      for (Offset i = 0; i < count; ++i) {
+         step[i] = std::clamp(step[i], 0.0f, MaxStep);
+         hx[i] = gx[start + i] * step[i] * 0.5f;
+         hy[i] = gy[start + i] * step[i] * 0.5f;
+         hz[i] = gz[start + i] * step[i] * 0.5f;
+         elapsed += step[i];
+      }
+
+      // Chain the small rotations, in the local frame                  
+      for (Offset i = 0; i < count; ++i) {
+         const float delta[4] {hx[i], hy[i], hz[i], 1};
+         float rotated[4];
+         Multiply(mOrientation, delta, rotated);
+         for (int c = 0; c < 4; ++c)
+            mOrientation[c] = rotated[c];
+      }
+
+      Normalize(mOrientation);
+   }
+
+   // Correct the tilt towards gravity, using the average acceleration  
+   const auto accels = batch.mAccel.GetCount();
+   if (accels and elapsed > 0) {
+      const auto ax = batch.mAccel.mX.GetRaw();
+      const auto ay = batch.mAccel.mY.GetRaw();
+      const auto az = batch.mAccel.mZ.GetRaw();
+      float up[3] {};
+      for (Offset i = 0; i < accels; ++i) {
+         up[0] += ax[i];
+         up[1] += ay[i];
+         up[2] += az[i];
+      }
+
+      const float length = std::sqrt(up[0] * up[0] + up[1] * up[1] + up[2] * up[2]) / accels;
+      if (std::abs(length - Gravity) < Gravity * GravityTolerance) {
+         // Measured 'up', rotated into the world, should be +Y         
+         const float norm = length * accels;
+         for (int c = 0; c < 3; ++c)
+            up[c] /= norm;
+         Rotate(mOrientation, up);
+
+         // Axis of the correction is up x (0, 1, 0)                    
+         const float axis[3] {-up[2], 0, up[0]};
+         const float sine = std::sqrt(axis[0] * axis[0] + axis[2] * axis[2]);
+         if (sine > 1e-6f) {
+            const float error = std::atan2(sine, up[1]);
+            const float fraction = std::min(1.0f, CorrectionRate * elapsed);
+            const float half = error * fraction * 0.5f;
+            const float scale = std::sin(half) / sine;
+            const float correction[4] {
+               axis[0] * scale, 0, axis[2] * scale, std::cos(half)
+            };
+
+            // Correction is in the world frame, so it goes on the left 
+            float corrected[4];
+            Multiply(correction, mOrientation, corrected);
+            for (int c = 0; c < 4; ++c)
+               mOrientation[c] = corrected[c];
+            Normalize(mOrientation);
+         }
+      }
+   }
+
+   // Delta is conjugate(previous) * current                            
+   const float inverse[4] {-previous[0], -previous[1], -previous[2], previous[3]};
+   float delta[4];
+   Multiply(inverse, mOrientation, delta);
+   return {delta[0], delta[1], delta[2], delta[3]};
+}
+
+/// Forget the orientation, and start integrating anew                        
+void OrientationFilter::Reset() {
+   mOrientation[0] = mOrientation[1] = mOrientation[2] = 0;
+   mOrientation[3] = 1;
+   mTimestamp = 0;
+}
@@ -0,0 +1,78 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "Common.hpp"
+
+
+///                                                                           
+///   Sensor stream                                                           
+///                                                                           
+/// Timestamped three-axis samples of a single sensor, kept as a structure of 
+/// arrays, so that consumers and the fusion step only touch packed floats    
+///                                                                           
+struct SensorStream {
+   // Timestamps of the samples, in nanoseconds, by the sensor's clock  
+   TMany<Uint64> mTimestamps;
+   // Components of the samples                                         
+   TMany<float> mX;
+   TMany<float> mY;
+   TMany<float> mZ;
+
+   void Push(Uint64, const float*);
+   Count GetCount() const noexcept;
+};
+
+
+///                                                                           
+///   Sensor batch                                                            
+///                                                                           
+/// All motion sensor samples a gamepad reported during a single frame. The   
+/// batches of all gamepads are delivered together, as the payload of a single
+/// Point event of this type, instead of as one event per sample              
+///                                                                           
+struct SensorBatch {
+   // The gamepad the samples came from                                 
+   SDL_JoystickID mDevice {};
+   // Angular velocity, in radians per second                           
+   SensorStream mGyro;
+   // Acceleration, including gravity, in meters per second squared     
+   SensorStream mAccel;
+   // Rotation of the gamepad since the previous batch, as a quaternion 
+   // (x, y, z, w) in the gamepad's local frame, for gyro aiming. Stays 
+   // identity, unless sensor fusion is enabled in the module           
+   Math::Vec4f mOrientationDelta {0, 0, 0, 1};
+};
+
+
+///                                                                           
+///   Orientation filter                                                      
+///                                                                           
+/// A complementary filter, that integrates the gyro for responsiveness, and  
+/// slowly pulls the result towards the gravity measured by the accelerometer 
+/// to cancel the gyro's drift in pitch and roll. Yaw isn't observable from   
+/// gravity, so it drifts freely, which is acceptable for relative aiming     
+///                                                                           
+struct OrientationFilter {
+   // Fraction of the tilt error corrected per second of samples        
+   static constexpr float CorrectionRate = 1.0f;
+   // Gaps between gyro samples longer than this are clamped, in seconds
+   static constexpr float MaxStep = 0.05f;
+   // Accelerometer is trusted only while it measures roughly gravity   
+   static constexpr float Gravity = 9.80665f;
+   static constexpr float GravityTolerance = 0.2f;
+
+private:
+   // Current orientation, as a quaternion (x, y, z, w)                 
+   float mOrientation[4] {0, 0, 0, 1};
+   // Timestamp of the last gyro sample                                 
+   Uint64 mTimestamp = 0;
+
+public:
+   Math::Vec4f Fuse(const SensorBatch&);
+   void Reset();
+};
@@ -0,0 +1,75 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#pragma once
+#include "InputSDL.hpp"
+#include <Langulus/Testing.hpp>
+#include <algorithm>
+
+
+/// State of 'hold' anticipators - any state other than Point, Begin and End  
+/// activates on Begin, executes on each update, and deactivates on End       
+inline const EventState Hold = static_cast<EventState>(1 + std::max({
+   static_cast<int>(EventState::Point),
+   static_cast<int>(EventState::Begin),
+   static_cast<int>(EventState::End)
+}));
+
+/// Access the gatherer behind a unit, created via abstractions               
+///   @param unit - the created unit                                          
+///   @return the gatherer                                                    
+inline InputGatherer* AsGatherer(const Many& unit) {
+   return static_cast<InputGatherer*>(unit.As<A::InputGatherer*>());
+}
+
+/// Access the listener behind a unit, created via abstractions               
+///   @param unit - the created unit                                          
+///   @return the listener                                                    
+inline InputListener* AsListener(const Many& unit) {
+   return static_cast<InputListener*>(unit.As<A::InputListener*>());
+}
+
+/// Access the module that produced a gatherer                                
+///   @param unit - the gatherer unit, created via abstractions               
+///   @return the module                                                      
+inline InputSDL* AsModule(const Many& unit) {
+   return AsGatherer(unit)->GetProducer();
+}
+
+/// Push a key press or release into the SDL queue                            
+///   @param scancode - the key                                               
+///   @param down - true to press, false to release                           
+///   @param timestamp - SDL time of the event, SDL stamps it if zero         
+inline void Press(SDL_Scancode scancode, bool down = true, Uint64 timestamp = 0) {
+   SDL_Event e {};
+   e.type = down ? SDL_EVENT_KEY_DOWN : SDL_EVENT_KEY_UP;
+   e.key.scancode = scancode;
+   e.key.timestamp = timestamp;
+   REQUIRE(SDL_PushEvent(&e) >= 0);
+}
+
+/// Push an OS auto-repeat of a held key into the SDL queue                   
+///   @param scancode - the key                                               
+inline void Repeat(SDL_Scancode scancode) {
+   SDL_Event e {};
+   e.type = SDL_EVENT_KEY_DOWN;
+   e.key.scancode = scancode;
+   e.key.repeat = true;
+   REQUIRE(SDL_PushEvent(&e) >= 0);
+}
+
+/// Create an anticipator in a listener                                       
+///   @param listener - the listener                                          
+///   @param args - the anticipator's descriptor                              
+///   @return the created anticipator                                         
+template<class...ARGS>
+Anticipator* Anticipate(InputListener* listener, ARGS&&...args) {
+   Verbs::Create creator {Construct::From<Anticipator>(std::forward<ARGS>(args)...)};
+   listener->Create(creator);
+   REQUIRE(creator.IsDone());
+   return creator.GetOutput().As<Anticipator*>();
+}
@@ -0,0 +1,146 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+/// Make an action map with a single binding                                  
+///   @param action - the action name                                         
+///   @param type - the event type that triggers the action                   
+///   @return the map                                                         
+static ActionMap Map(const Text& action, DMeta type) {
+   ActionMap map;
+   map.Bind(action, type);
+   return map;
+}
+
+SCENARIO("Rebinding actions", "[input][actions]") {
+   static Allocator::State memoryState;
+
+   GIVEN("An anticipator bound to an action, mapped to a key") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto handler = AsGatherer(gatherer);
+      const auto module = AsModule(gatherer);
+      const auto& metrics = module->GetMetrics();
+
+      const auto keyboard = module->GetSubscribers(InputCategory::Keyboard);
+      const auto wheel = module->GetSubscribers(InputCategory::MouseWheel);
+
+      const auto anticipator = Anticipate(AsListener(listener),
+         Traits::Name {Text {"Jump"}}, EventState::Point, Code {"1"});
+      REQUIRE(anticipator);
+
+      handler->SetActionMap(Map("Jump", MetaOf<Keys::Space>()));
+      REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == keyboard + 1);
+
+      Press(SDL_SCANCODE_SPACE);
+      root.Update({});
+      REQUIRE(metrics.mLast.mScripts == 1);
+      REQUIRE(anticipator->mTrigger == MetaOf<Keys::Space>());
+
+      WHEN("The action is rebound to another key") {
+         handler->SetActionMap(Map("Jump", MetaOf<Keys::W>()));
+
+         THEN("The subscription moves, without changing the count") {
+            REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == keyboard + 1);
+         }
+
+         THEN("The old key no longer triggers the action") {
+            Press(SDL_SCANCODE_SPACE);
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 0);
+         }
+
+         THEN("The new key triggers the same anticipator and script") {
+            const auto script = anticipator->mScript;
+            Press(SDL_SCANCODE_W);
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE(anticipator->mTrigger == MetaOf<Keys::W>());
+            REQUIRE(anticipator->mScript == script);
+         }
+      }
+
+      WHEN("The action is rebound to an event of another category") {
+         handler->SetActionMap(Map("Jump", MetaOf<Events::MouseScroll>()));
+
+         THEN("The subscription moves to that category") {
+            REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == keyboard);
+            REQUIRE(module->GetSubscribers(InputCategory::MouseWheel) == wheel + 1);
+         }
+      }
+
+      WHEN("The action map is rebound many times, then cleared") {
+         for (int i = 0; i < 10; ++i) {
+            handler->SetActionMap(Map("Jump", MetaOf<Keys::W>()));
+            handler->SetActionMap(Map("Jump", MetaOf<Events::MouseScroll>()));
+         }
+         handler->SetActionMap({});
+
+         THEN("Subscriptions are back where they started") {
+            REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == keyboard);
+            REQUIRE(module->GetSubscribers(InputCategory::MouseWheel) == wheel);
+         }
+      }
+   }
+
+   GIVEN("A hold anticipator bound to an action, while its key is held") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto handler = AsGatherer(gatherer);
+      const auto& metrics = AsModule(gatherer)->GetMetrics();
+
+      const auto anticipator = Anticipate(AsListener(listener),
+         Traits::Name {Text {"Move"}}, Hold, Code {"1"});
+      REQUIRE(anticipator);
+
+      handler->SetActionMap(Map("Move", MetaOf<Keys::Space>()));
+      Press(SDL_SCANCODE_SPACE);
+      root.Update({});
+      REQUIRE(metrics.mLast.mScripts == 1);
+      root.Update({});
+      REQUIRE(metrics.mLast.mScripts == 1);
+
+      WHEN("The action is rebound away from the held key, then the key is released") {
+         handler->SetActionMap(Map("Move", MetaOf<Keys::W>()));
+         root.Update({});
+         const auto afterRebind = metrics.mLast.mScripts;
+
+         Press(SDL_SCANCODE_SPACE, false);
+         root.Update({});
+
+         THEN("The hold stops right away, and doesn't wait for the new key") {
+            REQUIRE(afterRebind == 0);
+            REQUIRE(metrics.mLast.mScripts == 0);
+            REQUIRE_FALSE(anticipator->mActive);
+            REQUIRE_FALSE(AsListener(listener)->IsActive());
+         }
+      }
+
+      WHEN("The action is rebound, but the held key stays in it") {
+         ActionMap map;
+         map.Bind("Move", MetaOf<Keys::Space>());
+         map.Bind("Move", MetaOf<Keys::W>());
+         handler->SetActionMap(std::move(map));
+         root.Update({});
+
+         THEN("The hold goes on, until the key is released") {
+            REQUIRE(metrics.mLast.mScripts == 1);
+            Press(SDL_SCANCODE_SPACE, false);
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 0);
+            REQUIRE_FALSE(anticipator->mActive);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
@@ -0,0 +1,89 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+SCENARIO("Unregistering anticipators from the hot arrays", "[input][anticipators]") {
+   static Allocator::State memoryState;
+
+   GIVEN("Three anticipators, each reacting on pressing a different key") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto module = AsModule(gatherer);
+      const auto& metrics = module->GetMetrics();
+      const auto keyboard = module->GetSubscribers(InputCategory::Keyboard);
+
+      const auto handler = AsListener(listener);
+      const auto a = Anticipate(handler, MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+      const auto b = Anticipate(handler, MetaOf<Keys::B>(), EventState::Begin, Code {"1"});
+      const auto c = Anticipate(handler, MetaOf<Keys::C>(), EventState::Begin, Code {"1"});
+      REQUIRE(a->mSlot == 0);
+      REQUIRE(b->mSlot == 1);
+      REQUIRE(c->mSlot == 2);
+
+      // Press and release a key, then count the executed scripts       
+      const auto trigger = [&](SDL_Scancode key) {
+         Press(key);
+         Press(key, false);
+         root.Update({});
+         return metrics.mLast.mScripts;
+      };
+
+      WHEN("The first anticipator is unregistered") {
+         a->Detach();
+
+         THEN("The last one takes its slot") {
+            REQUIRE(c->mSlot == 0);
+            REQUIRE(b->mSlot == 1);
+         }
+
+         THEN("The moved anticipator still matches its own key only") {
+            REQUIRE(trigger(SDL_SCANCODE_A) == 0);
+            REQUIRE(trigger(SDL_SCANCODE_C) == 1);
+            REQUIRE(c->mTrigger == MetaOf<Keys::C>());
+            REQUIRE(trigger(SDL_SCANCODE_B) == 1);
+            REQUIRE(b->mTrigger == MetaOf<Keys::B>());
+         }
+
+         AND_WHEN("The moved anticipator is unregistered too") {
+            c->Detach();
+
+            THEN("The remaining one moves to the front, and still matches") {
+               REQUIRE(b->mSlot == 0);
+               REQUIRE(trigger(SDL_SCANCODE_C) == 0);
+               REQUIRE(trigger(SDL_SCANCODE_B) == 1);
+            }
+
+            AND_WHEN("The last anticipator is unregistered") {
+               b->Detach();
+
+               THEN("Nothing matches, and subscriptions are balanced") {
+                  REQUIRE(trigger(SDL_SCANCODE_B) == 0);
+                  REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == keyboard);
+               }
+            }
+         }
+      }
+
+      WHEN("The last anticipator is unregistered") {
+         c->Detach();
+
+         THEN("Nothing has to move") {
+            REQUIRE(a->mSlot == 0);
+            REQUIRE(b->mSlot == 1);
+            REQUIRE(trigger(SDL_SCANCODE_C) == 0);
+            REQUIRE(trigger(SDL_SCANCODE_A) == 1);
+            REQUIRE(trigger(SDL_SCANCODE_B) == 1);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
@@ -0,0 +1,76 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+/// An event type SDL never produces, like the ones other modules interact    
+/// with through gatherers                                                    
+struct CustomEvent {};
+
+SCENARIO("Toggling event categories at the source", "[input][categories]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A listener, before anything is anticipated") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto module = AsModule(gatherer);
+
+      THEN("Nothing is subscribed to, and SDL drops input at the source") {
+         REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == 0);
+         REQUIRE(module->GetSubscribers(InputCategory::MouseWheel) == 0);
+         REQUIRE_FALSE(SDL_EventEnabled(SDL_EVENT_KEY_DOWN));
+         REQUIRE_FALSE(SDL_EventEnabled(SDL_EVENT_MOUSE_WHEEL));
+      }
+
+      WHEN("A key is anticipated") {
+         const auto anticipator = Anticipate(AsListener(listener),
+            MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+
+         THEN("Only the keyboard is turned on") {
+            REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == 1);
+            REQUIRE(SDL_EventEnabled(SDL_EVENT_KEY_DOWN));
+            REQUIRE(SDL_EventEnabled(SDL_EVENT_KEY_UP));
+            REQUIRE_FALSE(SDL_EventEnabled(SDL_EVENT_MOUSE_WHEEL));
+         }
+
+         AND_WHEN("The anticipator is removed") {
+            anticipator->Detach();
+
+            THEN("The keyboard is turned off again") {
+               REQUIRE(module->GetSubscribers(InputCategory::Keyboard) == 0);
+               REQUIRE_FALSE(SDL_EventEnabled(SDL_EVENT_KEY_DOWN));
+               REQUIRE_FALSE(SDL_EventEnabled(SDL_EVENT_KEY_UP));
+            }
+         }
+      }
+
+      WHEN("A type SDL never produces is anticipated") {
+         const auto anticipator = Anticipate(AsListener(listener),
+            MetaOf<CustomEvent>(), EventState::Point, Code {"1"});
+
+         THEN("No category is turned on for it") {
+            for (int i = 0; i < static_cast<int>(InputCategory::Counter); ++i)
+               REQUIRE(module->GetSubscribers(static_cast<InputCategory>(i)) == 0);
+            REQUIRE_FALSE(SDL_EventEnabled(SDL_EVENT_KEY_DOWN));
+         }
+
+         AND_WHEN("The anticipator is removed") {
+            anticipator->Detach();
+
+            THEN("No category is touched") {
+               for (int i = 0; i < static_cast<int>(InputCategory::Counter); ++i)
+                  REQUIRE(module->GetSubscribers(static_cast<InputCategory>(i)) == 0);
+            }
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
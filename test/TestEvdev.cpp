@@ -0,0 +1,120 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+#ifdef __linux__
+#include <linux/input.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <array>
+
+
+/// Write input_event records to a stream                                     
+///   @param file - the write end of the stream                               
+///   @param records - (type, code, value) triplets to write                  
+static void Write(int file, std::initializer_list<std::array<int32_t, 3>> records) {
+   for (auto& record : records) {
+      input_event e {};
+      e.type = static_cast<uint16_t>(record[0]);
+      e.code = static_cast<uint16_t>(record[1]);
+      e.value = record[2];
+      REQUIRE(::write(file, &e, sizeof(e)) == static_cast<ssize_t>(sizeof(e)));
+   }
+}
+
+SCENARIO("Reading input directly from an evdev stream", "[input][evdev]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A gatherer that reads a pipe of input_event records") {
+      char directory[] = "/tmp/langulus-evdev-XXXXXX";
+      REQUIRE(::mkdtemp(directory));
+      const Text path = Text {directory} + "/stream";
+      const auto terminated = path.Terminate();
+      REQUIRE(::mkfifo(terminated.GetRaw(), 0600) == 0);
+
+      {
+         auto root = Thing::Root<false>("InputSDL");
+         auto gatherer = root.CreateUnit<A::InputGatherer>(InputDevice {path});
+         auto listener = root.CreateUnit<A::InputListener>();
+
+         // The reader is already open, so this doesn't block           
+         const int writer = ::open(terminated.GetRaw(), O_WRONLY | O_NONBLOCK);
+         REQUIRE(writer >= 0);
+
+         const auto handler = AsListener(listener);
+         Anticipate(handler, MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+         Anticipate(handler, MetaOf<Keys::A>(), EventState::End, Code {"1"});
+         Anticipate(handler, MetaOf<Events::MouseMove>(), EventState::Point, Code {"1"});
+
+         auto module = AsModule(gatherer);
+         module->EnableHistory(4);
+         const auto& metrics = module->GetMetrics();
+         InputState state;
+
+         WHEN("A key is pressed and released in separate reports") {
+            Write(writer, {{EV_KEY, KEY_A, 1}, {EV_SYN, SYN_REPORT, 0}});
+            root.Update({});
+
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE(module->GetHistory().GetState(module->GetHistory().GetFrame(), state));
+            REQUIRE(state.mHeld.GetCount() == 1);
+
+            Write(writer, {{EV_KEY, KEY_A, 0}, {EV_SYN, SYN_REPORT, 0}});
+            root.Update({});
+
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE(module->GetHistory().GetState(module->GetHistory().GetFrame(), state));
+            REQUIRE(state.mHeld.GetCount() == 0);
+         }
+
+         WHEN("Relative motion is reported in parts") {
+            Write(writer, {
+               {EV_REL, REL_X, 3}, {EV_REL, REL_Y, -2}, {EV_REL, REL_X, 4},
+               {EV_SYN, SYN_REPORT, 0}
+            });
+            root.Update({});
+
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE(module->GetHistory().GetState(module->GetHistory().GetFrame(), state));
+            REQUIRE(state.mMouse.x == 7);
+            REQUIRE(state.mMouse.y == -2);
+         }
+
+         WHEN("A record is split between two writes") {
+            input_event e {};
+            e.type = EV_KEY;
+            e.code = KEY_A;
+            e.value = 1;
+
+            // Nothing is decoded until the rest of the record arrives  
+            const auto raw = reinterpret_cast<const char*>(&e);
+            const auto half = static_cast<ssize_t>(sizeof(e) / 2);
+            const auto rest = static_cast<ssize_t>(sizeof(e)) - half;
+            REQUIRE(::write(writer, raw, half) == half);
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 0);
+
+            REQUIRE(::write(writer, raw + half, rest) == rest);
+            Write(writer, {{EV_SYN, SYN_REPORT, 0}});
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 1);
+         }
+
+         ::close(writer);
+      }
+
+      ::unlink(terminated.GetRaw());
+      ::rmdir(directory);
+
+      // Check for memory leaks after each cycle                        
+      REQUIRE(memoryState.Assert());
+   }
+}
+#endif
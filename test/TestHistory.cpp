@@ -0,0 +1,169 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+/// Make a key transition event                                               
+///   @param state - Begin or End                                             
+///   @return the event                                                       
+template<class KEY>
+Event Transition(EventState state) {
+   Event e;
+   e.mType = MetaOf<KEY>();
+   e.mState = state;
+   return e;
+}
+
+SCENARIO("Encoding input snapshots", "[input][history]") {
+   GIVEN("An idle frame") {
+      InputState state;
+      TMany<uint8_t> snapshot;
+      InputHistory::Encode(state, snapshot);
+
+      THEN("It is encoded as a single byte") {
+         REQUIRE(snapshot.GetCount() == 1);
+         REQUIRE(snapshot[0] == 0);
+      }
+   }
+
+   GIVEN("A frame with transitions, motion and scroll") {
+      InputState state;
+      state.mTransitions << uint16_t {0} << uint16_t {(300 << 1) | 1};
+      state.mMouse = {3.5f, -2};
+      state.mScroll = {0, 1};
+
+      TMany<uint8_t> snapshot;
+      InputHistory::Encode(state, snapshot);
+
+      WHEN("Decoded") {
+         InputState decoded;
+         InputHistory::Decode(snapshot, decoded);
+
+         THEN("All changes survive the round trip") {
+            REQUIRE(decoded.mTransitions.GetCount() == 2);
+            REQUIRE(decoded.mTransitions[0] == 0);
+            REQUIRE(decoded.mTransitions[1] == ((300 << 1) | 1));
+            REQUIRE(decoded.mMouse.x == 3.5f);
+            REQUIRE(decoded.mMouse.y == -2);
+            REQUIRE(decoded.mScroll.x == 0);
+            REQUIRE(decoded.mScroll.y == 1);
+         }
+      }
+   }
+}
+
+SCENARIO("Reconstructing historical input states", "[input][history]") {
+   GIVEN("A history, deeper than several keyframes") {
+      InputHistory history;
+      history.SetDepth(InputHistory::KeyframeInterval * 4);
+
+      // A is held for the whole recording, B for the second half only  
+      history.Record(Transition<Keys::A>(EventState::Begin));
+      history.Commit();
+      const auto pressed = history.GetFrame();
+
+      const auto total = InputHistory::KeyframeInterval * 6;
+      for (Count i = 1; i < total; ++i) {
+         if (i == total / 2)
+            history.Record(Transition<Keys::B>(EventState::Begin));
+         history.Commit();
+      }
+
+      WHEN("Each frame still in history is reconstructed") {
+         THEN("Held keys are correct, whether near a keyframe or not") {
+            InputState state;
+            const auto newest = history.GetFrame();
+            for (auto f = newest - history.GetCount() + 1; f <= newest; ++f) {
+               REQUIRE(history.GetState(f, state));
+               const Count expected = f >= pressed + total / 2 ? 2 : 1;
+               REQUIRE(state.mHeld.GetCount() == expected);
+            }
+         }
+      }
+
+      WHEN("A frame that left the ring is requested") {
+         InputState state;
+         THEN("It is refused") {
+            REQUIRE_FALSE(history.GetState(pressed, state));
+         }
+      }
+   }
+}
+
+SCENARIO("Re-enabling input history", "[input][history]") {
+   GIVEN("A history, disabled while a key was held") {
+      InputHistory history;
+      history.SetDepth(InputHistory::KeyframeInterval);
+      history.Record(Transition<Keys::A>(EventState::Begin));
+      history.Commit();
+
+      // The key is released meanwhile, but nothing records it          
+      history.SetDepth(0);
+
+      WHEN("History is enabled again, and a frame with no input is replayed") {
+         history.SetDepth(InputHistory::KeyframeInterval);
+         history.Commit();
+
+         InputState state;
+         REQUIRE(history.GetState(history.GetFrame(), state));
+         const auto transitions = history.Replay(state);
+
+         THEN("The stale key isn't released again") {
+            REQUIRE(transitions.GetCount() == 0);
+         }
+      }
+   }
+}
+
+SCENARIO("Re-injecting historical input", "[input][history]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A listener that reacts on pressing a key, with history enabled") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+
+      auto module = AsModule(gatherer);
+      module->EnableHistory(InputHistory::KeyframeInterval * 4);
+      const auto& metrics = module->GetMetrics();
+
+      // Press A, hold it for a while, then release it                  
+      Press(SDL_SCANCODE_A);
+      root.Update({});
+      REQUIRE(metrics.mLast.mScripts == 1);
+      for (int i = 0; i < 20; ++i)
+         root.Update({});
+      const auto held = module->GetHistory().GetFrame();
+      Press(SDL_SCANCODE_A, false);
+      root.Update({});
+
+      WHEN("A frame, during which the key was only held, is re-injected") {
+         REQUIRE(module->Reinject(held));
+         root.Update({});
+
+         THEN("The key is pressed again, to restore the hold") {
+            REQUIRE(metrics.mLast.mScripts == 1);
+         }
+      }
+
+      WHEN("The same frame is re-injected twice") {
+         REQUIRE(module->Reinject(held));
+         root.Update({});
+         REQUIRE(module->Reinject(held));
+         root.Update({});
+
+         THEN("The key isn't pressed again, it's still held") {
+            REQUIRE(metrics.mLast.mScripts == 0);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
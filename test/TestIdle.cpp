@@ -0,0 +1,123 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+#include <thread>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#endif
+
+using namespace std::chrono_literals;
+
+
+/// Press a key from another thread, after a delay, while Update is idle      
+///   @param delay - how long to wait before pressing                         
+///   @return the thread, join it after the update                            
+static std::thread PressLater(std::chrono::milliseconds delay) {
+   return std::thread {[delay] {
+      std::this_thread::sleep_for(delay);
+      SDL_Event e {};
+      e.type = SDL_EVENT_KEY_DOWN;
+      e.key.scancode = SDL_SCANCODE_A;
+      SDL_PushEvent(&e);
+   }};
+}
+
+/// Measure the wall time of a single update                                  
+///   @param root - the root to update                                        
+///   @return the time the update took                                        
+static std::chrono::steady_clock::duration Measure(Thing& root) {
+   const auto start = std::chrono::steady_clock::now();
+   root.Update({});
+   return std::chrono::steady_clock::now() - start;
+}
+
+SCENARIO("Idle mode requested by a gatherer", "[input][idle]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A gatherer that requests idle mode in its descriptor") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>(InputIdle {2s});
+      auto listener = root.CreateUnit<A::InputListener>();
+      Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+
+      // Drain whatever the gatherer's window produced, without idling  
+      auto module = AsModule(gatherer);
+      const auto& metrics = module->GetMetrics();
+      while (module->HasPendingWork())
+         root.Update({});
+
+      WHEN("A key is pressed while the update has nothing to do") {
+         auto presser = PressLater(200ms);
+         const auto elapsed = Measure(root);
+         presser.join();
+
+         THEN("The update waits for it, and wakes up as soon as it arrives") {
+            REQUIRE(elapsed >= 150ms);
+            REQUIRE(elapsed < 1s);
+            REQUIRE(metrics.mLast.mScripts == 1);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
+
+#ifdef __linux__
+SCENARIO("Idle mode with a device read directly", "[input][idle][evdev]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A gatherer that reads a pipe, with idle mode on") {
+      char directory[] = "/tmp/langulus-idle-XXXXXX";
+      REQUIRE(::mkdtemp(directory));
+      const Text path = Text {directory} + "/stream";
+      const auto terminated = path.Terminate();
+      REQUIRE(::mkfifo(terminated.GetRaw(), 0600) == 0);
+
+      {
+         auto root = Thing::Root<false>("InputSDL");
+         auto gatherer = root.CreateUnit<A::InputGatherer>(InputDevice {path});
+         auto listener = root.CreateUnit<A::InputListener>();
+
+         // Keep a writer open, so that the pipe doesn't report a hangup
+         const int writer = ::open(terminated.GetRaw(), O_WRONLY | O_NONBLOCK);
+         REQUIRE(writer >= 0);
+
+         Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+         auto module = AsModule(gatherer);
+         const auto& metrics = module->GetMetrics();
+         root.Update({});
+         module->SetIdleTimeout(2s);
+
+         WHEN("An SDL event arrives while the update waits on the pipe") {
+            auto presser = PressLater(50ms);
+            const auto elapsed = Measure(root);
+            presser.join();
+
+            THEN("The update wakes up for it, instead of waiting out the timeout") {
+               REQUIRE(elapsed < 1s);
+               REQUIRE(metrics.mLast.mScripts == 1);
+            }
+         }
+
+         module->SetIdleTimeout({});
+         ::close(writer);
+      }
+
+      ::unlink(terminated.GetRaw());
+      ::rmdir(directory);
+
+      // Check for memory leaks after each cycle                        
+      REQUIRE(memoryState.Assert());
+   }
+}
+#endif
@@ -0,0 +1,79 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+#include <thread>
+#include <vector>
+
+
+SCENARIO("Ingesting events from several threads", "[input][ingest]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A listener that reacts on a point event") {
+      static constexpr int Threads = 4;
+      static constexpr int Batches = 250;
+      static constexpr int BatchSize = 3;
+
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto anticipator = Anticipate(AsListener(listener),
+         MetaOf<Keys::A>(), EventState::Point, Code {"1"});
+      REQUIRE(anticipator);
+
+      WHEN("Each thread ingests numbered batches, while nothing consumes them") {
+         const auto handler = AsGatherer(gatherer);
+         std::vector<std::thread> threads;
+         for (int t = 0; t < Threads; ++t) {
+            threads.emplace_back([handler, t] {
+               for (int b = 0; b < Batches; ++b) {
+                  TMany<Event> batch;
+                  for (int i = 0; i < BatchSize; ++i) {
+                     Event e;
+                     e.mType = MetaOf<Keys::A>();
+                     e.mState = EventState::Point;
+                     e.mPayload = Many {(t * Batches + b) * BatchSize + i};
+                     batch << std::move(e);
+                  }
+                  handler->Ingest(std::move(batch));
+               }
+            });
+         }
+
+         for (auto& thread : threads)
+            thread.join();
+         root.Update({});
+
+         // Events of the same type and state are merged, so all of     
+         // them end up in a single payload, in the order of arrival    
+         const auto& payload = anticipator->mEvent.mPayload;
+
+         THEN("No event is lost") {
+            REQUIRE(AsModule(gatherer)->GetMetrics().mLast.mScripts == 1);
+            REQUIRE(payload.GetCount() == Threads * Batches * BatchSize);
+         }
+
+         THEN("Each thread's events arrive in the order they were ingested") {
+            int last[Threads];
+            for (auto& value : last)
+               value = -1;
+
+            for (Offset i = 0; i < payload.GetCount(); ++i) {
+               const auto value = payload.As<int>(i);
+               const auto thread = value / (Batches * BatchSize);
+               REQUIRE(thread >= 0);
+               REQUIRE(thread < Threads);
+               REQUIRE(value > last[thread]);
+               last[thread] = value;
+            }
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
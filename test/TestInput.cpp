@@ -5,8 +5,14 @@
 ///                                                                           
 /// SPDX-License-Identifier: GPL-3.0-or-later                                 
 ///                                                                           
-#include <Langulus/Input.hpp>
-#include <Langulus/Testing.hpp>
+#include "Common.hpp"
+#include <chrono>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdlib>
+#endif
 
 
 SCENARIO("Input handler creation", "[input]") {
@@ -36,6 +42,26 @@ SCENARIO("Input handler creation", "[input]") {
             REQUIRE(root.GetUnits().GetCount() == 2);
          }
 
+         WHEN("Anticipators are created in the listener") {
+            auto gatherer = root.CreateUnit<A::InputGatherer>();
+            auto listener = root.CreateUnit<A::InputListener>();
+
+            // The anticipators outlive the listener's teardown, and    
+            // must not reach for the gatherer or module afterwards     
+            const auto handler = AsListener(listener);
+            Anticipate(handler, MetaOf<Keys::Space>(), EventState::Point, Code {"1"});
+            Anticipate(handler, MetaOf<Keys::W>(), EventState::Begin, Code {"1"});
+            Anticipate(handler, MetaOf<Events::MouseMove>(), EventState::Point, Code {"1"});
+
+            // Update once                                              
+            root.Update({});
+            root.DumpHierarchy();
+
+            REQUIRE(gatherer.GetCount() == 1);
+            REQUIRE(listener.GetCount() == 1);
+            REQUIRE(root.GetUnits().GetCount() == 2);
+         }
+
       #if LANGULUS_FEATURE(MANAGED_REFLECTION)
          WHEN("The input gatherer is created via tokens") {
             auto gatherer = root.CreateUnitToken("InputGatherer");
@@ -63,3 +89,68 @@ SCENARIO("Input handler creation", "[input]") {
    }
 }
 
+
+/// Time whole init and shutdown cycles - from loading the module, through    
+/// creating the units and a single update, to destroying everything          
+///   @param cycles - the number of cycles to time                            
+///   @param create - creates the units of a cycle in its root                
+///   @return the average time of a cycle, in microseconds                    
+template<class F>
+static auto TimeCycles(int cycles, F&& create) {
+   using namespace std::chrono;
+   const auto start = steady_clock::now();
+   for (int i = 0; i < cycles; ++i) {
+      auto root = Thing::Root<false>("InputSDL");
+      create(root);
+      root.Update({});
+   }
+   return duration_cast<microseconds>(steady_clock::now() - start).count() / cycles;
+}
+
+SCENARIO("Input handler startup and shutdown cost", "[input][startup]") {
+   static Allocator::State memoryState;
+   static constexpr int Cycles = 10;
+
+   GIVEN("Init and shutdown cycles, like the ones above") {
+      WHEN("Each cycle has a gatherer, that makes a focus window") {
+         const auto average = TimeCycles(Cycles, [](Thing& root) {
+            root.CreateUnit<A::InputGatherer>();
+            root.CreateUnit<A::InputListener>();
+         });
+         Logger::Info("Cycle with a focus window: ", average, " us");
+
+         THEN("Every cycle is complete") {
+            REQUIRE(average >= 0);
+            REQUIRE_FALSE(SDL_WasInit(SDL_INIT_VIDEO));
+         }
+      }
+
+   #ifdef __linux__
+      WHEN("Each cycle has a gatherer, that only reads a device") {
+         // A gatherer that only reads a device never starts video      
+         char directory[] = "/tmp/langulus-bench-XXXXXX";
+         REQUIRE(::mkdtemp(directory));
+         const Text path = Text {directory} + "/stream";
+         const auto terminated = path.Terminate();
+         REQUIRE(::mkfifo(terminated.GetRaw(), 0600) == 0);
+
+         const auto average = TimeCycles(Cycles, [&](Thing& root) {
+            root.CreateUnit<A::InputGatherer>(InputDevice {path});
+            root.CreateUnit<A::InputListener>();
+         });
+         Logger::Info("Cycle that only reads a device: ", average, " us");
+
+         ::unlink(terminated.GetRaw());
+         ::rmdir(directory);
+
+         THEN("Every cycle is complete") {
+            REQUIRE(average >= 0);
+            REQUIRE_FALSE(SDL_WasInit(SDL_INIT_VIDEO));
+         }
+      }
+   #endif
+   }
+
+   // Check for memory leaks after the cycles                           
+   REQUIRE(memoryState.Assert());
+}
@@ -0,0 +1,79 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+SCENARIO("Input latency metrics", "[input][metrics]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A listener that reacts on a single key") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+
+      auto module = AsModule(gatherer);
+      const auto& metrics = module->GetMetrics();
+      root.Update({});
+      const auto samples = metrics.GetLatencySamples();
+
+      WHEN("The key is pressed, and picked up by a late sample") {
+         Press(SDL_SCANCODE_A);
+         REQUIRE(module->Sample());
+
+         THEN("The script triggered by the sample is sampled") {
+            REQUIRE(metrics.GetLatencySamples() == samples + 1);
+         }
+      }
+
+      WHEN("Another key is pressed, that triggers nothing") {
+         Press(SDL_SCANCODE_B);
+         root.Update({});
+
+         THEN("No latency is sampled") {
+            REQUIRE(metrics.mLast.mScripts == 0);
+            REQUIRE(metrics.GetLatencySamples() == samples);
+         }
+      }
+
+      WHEN("Both keys are pressed in a single update") {
+         Press(SDL_SCANCODE_B);
+         Press(SDL_SCANCODE_A);
+         root.Update({});
+
+         THEN("Only the triggering key is sampled") {
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE(metrics.GetLatencySamples() == samples + 1);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Input latency percentiles", "[input][metrics]") {
+   GIVEN("Three fast samples and a slow one") {
+      InputMetrics metrics;
+      for (int i = 0; i < 3; ++i)
+         metrics.Sampled(0, 1000);
+      metrics.Sampled(0, 1000000);
+      REQUIRE(metrics.GetLatencySamples() == 4);
+
+      THEN("Percentiles up to the fast samples fall in the first bucket") {
+         REQUIRE(metrics.GetLatencyPercentile(0) == 2000);
+         REQUIRE(metrics.GetLatencyPercentile(0.5) == 2000);
+         REQUIRE(metrics.GetLatencyPercentile(0.75) == 2000);
+      }
+
+      THEN("Percentiles above them, including p100, fall in the slow one's") {
+         REQUIRE(metrics.GetLatencyPercentile(0.76) == 1024000);
+         REQUIRE(metrics.GetLatencyPercentile(1) == 1024000);
+      }
+   }
+}
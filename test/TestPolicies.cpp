@@ -0,0 +1,107 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+#include <thread>
+
+using namespace std::chrono_literals;
+
+
+/// Press a key at a given SDL time, and update once                          
+///   @param root - the root to update                                        
+///   @param timestamp - the SDL time of the press                            
+static void PressAt(Thing& root, Uint64 timestamp) {
+   Press(SDL_SCANCODE_A, true, timestamp);
+   root.Update({});
+}
+
+SCENARIO("Anticipator policies", "[input][policy]") {
+   static Allocator::State memoryState;
+
+   // Policies measure time between the events, as stamped by SDL, and  
+   // not between the updates that dispatch them                        
+   constexpr Uint64 Millisecond = 1000000;
+
+   GIVEN("A listener that reacts on pressing a key") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto& metrics = AsModule(gatherer)->GetMetrics();
+      AnticipatorPolicy policy;
+
+      WHEN("Presses arrive within the cooldown") {
+         policy.mCooldown = 100ms;
+         Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, policy, Code {"1"});
+         root.Update({});
+         const auto start = SDL_GetTicksNS();
+
+         THEN("Only those after it trigger the script") {
+            PressAt(root, start);
+            REQUIRE(metrics.mLast.mScripts == 1);
+            PressAt(root, start + 50 * Millisecond);
+            REQUIRE(metrics.mLast.mScripts == 0);
+            REQUIRE(metrics.mLast.mDenied == 1);
+            PressAt(root, start + 100 * Millisecond);
+            REQUIRE(metrics.mLast.mScripts == 1);
+         }
+      }
+
+      WHEN("Presses bounce, each one sooner than the debounce after the last") {
+         policy.mDebounce = 50ms;
+         Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, policy, Code {"1"});
+         root.Update({});
+         const auto start = SDL_GetTicksNS();
+
+         THEN("Each bounce restarts the window, until the key settles") {
+            PressAt(root, start);
+            REQUIRE(metrics.mLast.mScripts == 1);
+            PressAt(root, start + 30 * Millisecond);
+            REQUIRE(metrics.mLast.mDenied == 1);
+            PressAt(root, start + 60 * Millisecond);
+            REQUIRE(metrics.mLast.mDenied == 1);
+            PressAt(root, start + 110 * Millisecond);
+            REQUIRE(metrics.mLast.mScripts == 1);
+         }
+      }
+
+      WHEN("Presses arrive faster than the throttle") {
+         policy.mThrottle = 50ms;
+         Anticipate(AsListener(listener), MetaOf<Keys::A>(), EventState::Begin, policy, Code {"1"});
+         root.Update({});
+         const auto start = SDL_GetTicksNS();
+         PressAt(root, start);
+         REQUIRE(metrics.mLast.mScripts == 1);
+         const auto samples = metrics.GetLatencySamples();
+
+         PressAt(root, start + 10 * Millisecond);
+         PressAt(root, start + 20 * Millisecond);
+
+         THEN("They aren't dropped, but deferred") {
+            REQUIRE(metrics.mLast.mScripts == 0);
+            REQUIRE(metrics.mLast.mDenied == 0);
+         }
+
+         THEN("Only the latest of them executes, once the throttle expires") {
+            std::this_thread::sleep_for(60ms);
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 1);
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 0);
+         }
+
+         THEN("The deferred trigger samples the latency of its own event") {
+            std::this_thread::sleep_for(60ms);
+            root.Update({});
+            REQUIRE(metrics.GetLatencySamples() == samples + 1);
+            REQUIRE(metrics.GetLatencyPercentile(1) >= 40000000);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
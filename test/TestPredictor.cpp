@@ -0,0 +1,110 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+static constexpr Uint64 Millisecond = 1'000'000;
+
+
+SCENARIO("Predicting relative motion", "[input][prediction]") {
+   GIVEN("A predictor, fed a steady motion to the right") {
+      MotionPredictor predictor;
+      Uint64 now = 1000 * Millisecond;
+      for (int i = 0; i < 10; ++i) {
+         predictor.Sample(now, {1, 0});
+         now += Millisecond;
+      }
+      const auto last = now - Millisecond;
+
+      REQUIRE(predictor.GetVelocity().x == Approx(1000).epsilon(1e-3));
+      REQUIRE(predictor.PredictDelta(last + 10 * Millisecond).x > 0);
+
+      WHEN("The motion reverses") {
+         predictor.Sample(now, {-2, 0});
+
+         THEN("The old estimate is discarded, instead of smoothed") {
+            REQUIRE(predictor.GetVelocity().x == Approx(-2000).epsilon(1e-3));
+            REQUIRE(predictor.GetVelocity().y == 0);
+            REQUIRE(predictor.PredictDelta(now + 10 * Millisecond).x < 0);
+         }
+      }
+
+      WHEN("The next sample comes after the motion went stale") {
+         now = last + MotionPredictor::StaleAfter + Millisecond;
+         predictor.Sample(now, {5, 0});
+
+         THEN("The estimate restarts, and nothing is predicted yet") {
+            REQUIRE(predictor.GetVelocity().x == 0);
+            REQUIRE(predictor.GetVelocity().y == 0);
+            REQUIRE(predictor.PredictDelta(now + 10 * Millisecond).x == 0);
+         }
+
+         THEN("The sampled deltas still add up") {
+            REQUIRE(predictor.GetPosition().x == 15);
+         }
+      }
+
+      WHEN("The prediction is for a time when the motion would be stale") {
+         const auto delta = predictor.PredictDelta(last + MotionPredictor::StaleAfter + Millisecond);
+
+         THEN("Nothing is predicted") {
+            REQUIRE(delta.x == 0);
+            REQUIRE(delta.y == 0);
+         }
+      }
+   }
+
+   GIVEN("A predictor, fed a strongly accelerating motion") {
+      MotionPredictor predictor;
+      Uint64 now = 1000 * Millisecond;
+      for (float delta = 1; delta <= 64; delta *= 2) {
+         predictor.Sample(now, {delta, 0});
+         now += Millisecond;
+      }
+      const auto last = now - Millisecond;
+
+      WHEN("Predicting beyond the horizon") {
+         const auto delta = predictor.PredictDelta(last + 80 * Millisecond);
+
+         THEN("The prediction is at most twice the linear one, up to the horizon") {
+            const float horizon = MotionPredictor::MaxHorizon * 1e-9f;
+            const float linear = predictor.GetVelocity().x * horizon;
+            REQUIRE(linear > 0);
+            REQUIRE(delta.x == Approx(2 * linear).epsilon(1e-4));
+            REQUIRE(delta.y == 0);
+         }
+      }
+   }
+
+   GIVEN("A predictor, fed its first two samples") {
+      MotionPredictor predictor;
+      Uint64 now = 1000 * Millisecond;
+      predictor.Sample(now, {1, 0});
+      now += Millisecond;
+      predictor.Sample(now, {2, 0});
+
+      THEN("The velocity is seeded from the first real delta, not smoothed against zero") {
+         REQUIRE(predictor.GetVelocity().x == Approx(2000).epsilon(1e-3));
+         REQUIRE(predictor.GetVelocity().y == 0);
+      }
+
+      WHEN("Another delta arrives with the same timestamp, then one a millisecond later") {
+         predictor.Sample(now, {2, 0});
+         REQUIRE(predictor.GetVelocity().x == Approx(2000).epsilon(1e-3));
+
+         now += Millisecond;
+         predictor.Sample(now, {2, 0});
+
+         THEN("Both deltas are folded into the next estimate") {
+            // Four units in a millisecond, smoothed against 2000       
+            const float expected = 2000 + (4000 - 2000) * MotionPredictor::VelocitySmoothing;
+            REQUIRE(predictor.GetVelocity().x == Approx(expected).epsilon(1e-3));
+            REQUIRE(predictor.GetPosition().x == 7);
+         }
+      }
+   }
+}
@@ -0,0 +1,126 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+SCENARIO("Propagating key auto-repeats by priority", "[input][repeats]") {
+   static Allocator::State memoryState;
+
+   GIVEN("Two listeners of different priority") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto high = root.CreateUnit<A::InputListener>(ListenerPolicy {1});
+      auto low = root.CreateUnit<A::InputListener>();
+      const auto& metrics = AsModule(gatherer)->GetMetrics();
+
+      AnticipatorPolicy repeat;
+      repeat.mRepeat = true;
+      const auto below = Anticipate(AsListener(low),
+         MetaOf<Keys::A>(), EventState::Point, repeat, Code {"1"});
+
+      WHEN("Both react on the repeats of a key") {
+         Anticipate(AsListener(high),
+            MetaOf<Keys::A>(), EventState::Point, repeat, Code {"1"});
+         root.Update({});
+         Repeat(SDL_SCANCODE_A);
+         root.Update({});
+
+         THEN("Both see the repeat") {
+            REQUIRE(metrics.mLast.mScripts == 2);
+            REQUIRE(below->mTrigger == MetaOf<Keys::A>());
+         }
+      }
+
+      WHEN("The one above reacts on the repeats, and consumes them") {
+         auto consume = repeat;
+         consume.mConsume = true;
+         Anticipate(AsListener(high),
+            MetaOf<Keys::A>(), EventState::Point, consume, Code {"1"});
+         root.Update({});
+         Repeat(SDL_SCANCODE_A);
+         root.Update({});
+
+         THEN("The repeat doesn't reach the one below") {
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE_FALSE(below->mTrigger);
+         }
+      }
+
+      WHEN("The one above holds the key and consumes it, ignoring repeats") {
+         AnticipatorPolicy consume;
+         consume.mConsume = true;
+         Anticipate(AsListener(high),
+            MetaOf<Keys::A>(), Hold, consume, Code {"1"});
+         Press(SDL_SCANCODE_A);
+         root.Update({});
+         Repeat(SDL_SCANCODE_A);
+         root.Update({});
+
+         THEN("The repeats of the held key don't leak below either") {
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE_FALSE(below->mTrigger);
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
+
+SCENARIO("Dropping key auto-repeats at the source", "[input][repeats]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A listener that reacts on pressing a key, but not on its repeats") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto& metrics = AsModule(gatherer)->GetMetrics();
+      Anticipate(AsListener(listener),
+         MetaOf<Keys::A>(), EventState::Point, Code {"1"});
+      root.Update({});
+
+      WHEN("The key repeats") {
+         Repeat(SDL_SCANCODE_A);
+         root.Update({});
+
+         THEN("The repeat is never translated") {
+            REQUIRE(metrics.mLast.mTranslated == 0);
+            REQUIRE(metrics.mLast.mScripts == 0);
+         }
+      }
+
+      WHEN("Another anticipator opts in to the repeats") {
+         AnticipatorPolicy repeat;
+         repeat.mRepeat = true;
+         const auto anticipator = Anticipate(AsListener(listener),
+            MetaOf<Keys::A>(), EventState::Point, repeat, Code {"1"});
+         Repeat(SDL_SCANCODE_A);
+         root.Update({});
+
+         THEN("The repeat is delivered to it, and only to it") {
+            REQUIRE(metrics.mLast.mTranslated == 1);
+            REQUIRE(metrics.mLast.mScripts == 1);
+            REQUIRE(anticipator->mTrigger == MetaOf<Keys::A>());
+         }
+
+         AND_WHEN("That anticipator is removed, and the key repeats again") {
+            anticipator->Detach();
+            Repeat(SDL_SCANCODE_A);
+            root.Update({});
+
+            THEN("Repeats are dropped at the source again") {
+               REQUIRE(metrics.mLast.mTranslated == 0);
+               REQUIRE(metrics.mLast.mScripts == 0);
+            }
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
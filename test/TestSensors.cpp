@@ -0,0 +1,185 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+#include <cmath>
+
+static constexpr float Pi = 3.14159265358979f;
+static constexpr Uint64 Second = 1'000'000'000;
+
+
+/// Compose two rotations, as quaternions (x, y, z, w)                        
+///   @param a - the first rotation                                           
+///   @param b - the rotation that follows, in the local frame of a           
+///   @return a * b                                                           
+static Math::Vec4f Compose(const Math::Vec4f& a, const Math::Vec4f& b) {
+   return {
+      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+   };
+}
+
+SCENARIO("Fusing gamepad motion sensors", "[input][sensors]") {
+   GIVEN("An orientation filter") {
+      OrientationFilter filter;
+
+      WHEN("A constant yaw rate of 90 degrees per second is integrated for a second") {
+         // 101 samples, 10ms apart - the first one only starts the clock
+         SensorBatch batch;
+         const float rate[3] {0, Pi / 2, 0};
+         for (Uint64 i = 0; i <= 100; ++i)
+            batch.mGyro.Push(Second + i * Second / 100, rate);
+
+         const auto delta = filter.Fuse(batch);
+
+         THEN("The gamepad turned 90 degrees around its vertical axis") {
+            REQUIRE(delta.x == Approx(0).margin(1e-4));
+            REQUIRE(delta.y == Approx(std::sin(Pi / 4)).margin(1e-3));
+            REQUIRE(delta.z == Approx(0).margin(1e-4));
+            REQUIRE(delta.w == Approx(std::cos(Pi / 4)).margin(1e-3));
+         }
+      }
+
+      WHEN("The same rate is split into several batches") {
+         const float rate[3] {0, Pi / 2, 0};
+         Math::Vec4f total {0, 0, 0, 1};
+         for (Uint64 b = 0; b < 4; ++b) {
+            SensorBatch batch;
+            for (Uint64 i = 0; i < 25; ++i)
+               batch.mGyro.Push(Second + (b * 25 + i) * Second / 100, rate);
+            total = Compose(total, filter.Fuse(batch));
+         }
+
+         THEN("The time between the batches is integrated too") {
+            // Samples span 0.99s, the first one only starts the clock  
+            const float half = Pi / 2 * 0.99f / 2;
+            REQUIRE(total.y == Approx(std::sin(half)).margin(1e-3));
+            REQUIRE(total.w == Approx(std::cos(half)).margin(1e-3));
+         }
+      }
+
+      WHEN("A still gamepad is rolled by 30 degrees, as told by gravity") {
+         // The accelerometer measures 'up' - rolled away from +Y       
+         const float roll = Pi / 6;
+         const float still[3] {0, 0, 0};
+         const float up[3] {
+            std::sin(roll) * OrientationFilter::Gravity,
+            std::cos(roll) * OrientationFilter::Gravity,
+            0
+         };
+
+         // A hundred batches of a tenth of a second each               
+         Math::Vec4f total {0, 0, 0, 1};
+         Math::Vec4f delta;
+         for (Uint64 b = 0; b < 100; ++b) {
+            SensorBatch batch;
+            for (Uint64 i = 0; i < 10; ++i) {
+               const auto timestamp = Second + (b * 10 + i) * Second / 100;
+               batch.mGyro.Push(timestamp, still);
+               batch.mAccel.Push(timestamp, up);
+            }
+
+            delta = filter.Fuse(batch);
+            total = Compose(total, delta);
+         }
+
+         THEN("The tilt converges to the roll, and corrections stop") {
+            REQUIRE(total.x == Approx(0).margin(1e-4));
+            REQUIRE(total.y == Approx(0).margin(1e-4));
+            REQUIRE(total.z == Approx(std::sin(roll / 2)).margin(1e-3));
+            REQUIRE(total.w == Approx(std::cos(roll / 2)).margin(1e-3));
+            REQUIRE(delta.w == Approx(1).margin(1e-6));
+         }
+      }
+
+      WHEN("The accelerometer measures something other than gravity") {
+         const float still[3] {0, 0, 0};
+         const float shaken[3] {OrientationFilter::Gravity * 2, 0, 0};
+         SensorBatch batch;
+         for (Uint64 i = 0; i < 10; ++i) {
+            batch.mGyro.Push(Second + i * Second / 100, still);
+            batch.mAccel.Push(Second + i * Second / 100, shaken);
+         }
+
+         const auto delta = filter.Fuse(batch);
+
+         THEN("It isn't trusted, and the orientation stays") {
+            REQUIRE(delta.w == Approx(1).margin(1e-6));
+         }
+      }
+   }
+}
+
+/// Virtual joystick sensors aren't declared by every SDL revision - see      
+/// test/CMakeLists.txt                                                       
+#ifdef LANGULUS_MOD_INPUTSDL_VIRTUAL_SENSORS
+SCENARIO("Collecting motion sensors of a virtual gamepad", "[input][sensors]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A listener that anticipates sensor batches") {
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>();
+      auto listener = root.CreateUnit<A::InputListener>();
+      auto module = AsModule(gatherer);
+      const auto& metrics = module->GetMetrics();
+
+      // Anticipating batches starts the gamepad subsystem              
+      REQUIRE_FALSE(SDL_WasInit(SDL_INIT_GAMEPAD));
+      Anticipate(AsListener(listener), MetaOf<SensorBatch>(), EventState::Point, Code {"1"});
+      REQUIRE(SDL_WasInit(SDL_INIT_GAMEPAD));
+
+      // Attach a virtual gamepad, that declares gyro and accelerometer 
+      // - works headless, without any real device                      
+      const SDL_VirtualJoystickSensorDesc sensors[] {
+         {SDL_SENSOR_GYRO, 100.0f},
+         {SDL_SENSOR_ACCEL, 100.0f}
+      };
+
+      SDL_VirtualJoystickDesc desc {};
+      desc.version = SDL_VIRTUAL_JOYSTICK_DESC_VERSION;
+      desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+      desc.naxes = SDL_GAMEPAD_AXIS_MAX;
+      desc.nbuttons = SDL_GAMEPAD_BUTTON_MAX;
+      desc.nsensors = 2;
+      desc.sensors = sensors;
+      const auto id = SDL_AttachVirtualJoystick(&desc);
+      REQUIRE(id);
+      const auto joystick = SDL_OpenJoystick(id);
+      REQUIRE(joystick);
+
+      // The module opens the gamepad and its sensors, once it's added  
+      root.Update({});
+
+      WHEN("Several samples of both sensors arrive before a poll") {
+         const float gyro[3] {0, 1, 0};
+         const float accel[3] {0, OrientationFilter::Gravity, 0};
+         for (Uint64 i = 1; i <= 4; ++i) {
+            REQUIRE(SDL_SendJoystickVirtualSensorData(joystick, SDL_SENSOR_GYRO, i * Second / 100, gyro, 3) == 0);
+            REQUIRE(SDL_SendJoystickVirtualSensorData(joystick, SDL_SENSOR_ACCEL, i * Second / 100, accel, 3) == 0);
+         }
+         root.Update({});
+
+         THEN("They are delivered as a single Point event") {
+            REQUIRE(metrics.mLast.mScripts == 1);
+         }
+
+         THEN("The next poll, without samples, delivers nothing") {
+            root.Update({});
+            REQUIRE(metrics.mLast.mScripts == 0);
+         }
+      }
+
+      SDL_CloseJoystick(joystick);
+      SDL_DetachVirtualJoystick(id);
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
+#endif
@@ -0,0 +1,98 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+SCENARIO("Starting SDL subsystems on demand", "[input][subsystems]") {
+   static Allocator::State memoryState;
+
+   GIVEN("A gatherer that only reads a device, which doesn't exist") {
+      // Without a window, the video subsystem has no users             
+      auto root = Thing::Root<false>("InputSDL");
+      auto gatherer = root.CreateUnit<A::InputGatherer>(InputDevice {"/nonexistent/langulus-input"});
+      auto listener = root.CreateUnit<A::InputListener>();
+      const auto module = AsModule(gatherer);
+
+      THEN("No subsystem is started") {
+         REQUIRE(module->GetSubsystemUsers(SDL_INIT_VIDEO) == 0);
+         REQUIRE(module->GetSubsystemUsers(SDL_INIT_GAMEPAD) == 0);
+         REQUIRE(module->GetSubsystemUsers(SDL_INIT_JOYSTICK) == 0);
+         REQUIRE_FALSE(SDL_WasInit(SDL_INIT_VIDEO));
+         REQUIRE_FALSE(SDL_WasInit(SDL_INIT_GAMEPAD));
+         REQUIRE_FALSE(SDL_WasInit(SDL_INIT_JOYSTICK));
+      }
+
+      WHEN("Sensor batches are anticipated") {
+         const auto anticipator = Anticipate(AsListener(listener),
+            MetaOf<SensorBatch>(), EventState::Point, Code {"1"});
+
+         THEN("Only the gamepad subsystem is started, along with the joystick subsystem SDL starts for it") {
+            REQUIRE(module->GetSubsystemUsers(SDL_INIT_GAMEPAD) == 1);
+            REQUIRE(module->GetSubsystemUsers(SDL_INIT_JOYSTICK) == 0);
+            REQUIRE(module->GetSubsystemUsers(SDL_INIT_VIDEO) == 0);
+            REQUIRE(SDL_WasInit(SDL_INIT_GAMEPAD));
+            REQUIRE(SDL_WasInit(SDL_INIT_JOYSTICK));
+            REQUIRE_FALSE(SDL_WasInit(SDL_INIT_VIDEO));
+         }
+
+      #ifdef LANGULUS_MOD_INPUTSDL_VIRTUAL_SENSORS
+         AND_WHEN("A gamepad with motion sensors appears") {
+            const SDL_VirtualJoystickSensorDesc sensors[] {
+               {SDL_SENSOR_GYRO, 100.0f},
+               {SDL_SENSOR_ACCEL, 100.0f}
+            };
+
+            SDL_VirtualJoystickDesc desc {};
+            desc.version = SDL_VIRTUAL_JOYSTICK_DESC_VERSION;
+            desc.type = SDL_JOYSTICK_TYPE_GAMEPAD;
+            desc.naxes = SDL_GAMEPAD_AXIS_MAX;
+            desc.nbuttons = SDL_GAMEPAD_BUTTON_MAX;
+            desc.nsensors = 2;
+            desc.sensors = sensors;
+            const auto id = SDL_AttachVirtualJoystick(&desc);
+            REQUIRE(id);
+            bool attached = true;
+            root.Update({});
+
+            THEN("It is opened, without acquiring the subsystem again") {
+               REQUIRE(SDL_GetGamepadFromID(id));
+               REQUIRE(module->GetSubsystemUsers(SDL_INIT_GAMEPAD) == 1);
+            }
+
+            AND_WHEN("It is removed") {
+               SDL_DetachVirtualJoystick(id);
+               attached = false;
+               root.Update({});
+
+               THEN("It is closed, and the subsystem stays for the next one") {
+                  REQUIRE_FALSE(SDL_GetGamepadFromID(id));
+                  REQUIRE(module->GetSubsystemUsers(SDL_INIT_GAMEPAD) == 1);
+                  REQUIRE(SDL_WasInit(SDL_INIT_GAMEPAD));
+               }
+            }
+
+            if (attached)
+               SDL_DetachVirtualJoystick(id);
+         }
+      #endif
+
+         AND_WHEN("The anticipator is removed") {
+            anticipator->Detach();
+
+            THEN("The gamepad subsystem is shut down, along with the joystick one") {
+               REQUIRE(module->GetSubsystemUsers(SDL_INIT_GAMEPAD) == 0);
+               REQUIRE_FALSE(SDL_WasInit(SDL_INIT_GAMEPAD));
+               REQUIRE_FALSE(SDL_WasInit(SDL_INIT_JOYSTICK));
+            }
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}
@@ -0,0 +1,82 @@
+///                                                                           
+/// Langulus::Module::InputSDL                                                
+/// Copyright (c) 2024 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: GPL-3.0-or-later                                 
+///                                                                           
+#include "Common.hpp"
+
+
+/// Push a key press, that occurred in a window, into the SDL queue           
+///   @param window - the SDL window identifier, zero if none                 
+static void PressIn(SDL_WindowID window) {
+   SDL_Event e {};
+   e.type = SDL_EVENT_KEY_DOWN;
+   e.key.scancode = SDL_SCANCODE_A;
+   e.key.windowID = window;
+   REQUIRE(SDL_PushEvent(&e) >= 0);
+}
+
+/// Create a listener in a specific gatherer, that reacts on pressing a key   
+///   @param gatherer - the gatherer unit, created via abstractions           
+///   @return the listener's anticipator                                      
+static Anticipator* Listen(const Many& gatherer) {
+   Verbs::Create creator {Construct::From<InputListener>()};
+   AsGatherer(gatherer)->Create(creator);
+   REQUIRE(creator.IsDone());
+
+   const auto listener = creator.GetOutput().As<InputListener*>();
+   return Anticipate(listener, MetaOf<Keys::A>(), EventState::Begin, Code {"1"});
+}
+
+SCENARIO("Routing events by window", "[input][windows]") {
+   static Allocator::State memoryState;
+
+   GIVEN("Two gatherers, each bound to a window of its own") {
+      // SDL accepts any window identifier in pushed events, so these   
+      // stand in for windows created by a window module                
+      constexpr SDL_WindowID LeftWindow = 1001;
+      constexpr SDL_WindowID RightWindow = 1002;
+
+      auto root = Thing::Root<false>("InputSDL");
+      auto left = root.CreateUnit<A::InputGatherer>(InputWindow {LeftWindow});
+      auto right = root.CreateUnit<A::InputGatherer>(InputWindow {RightWindow});
+      const auto inLeft = Listen(left);
+      const auto inRight = Listen(right);
+      root.Update({});
+
+      WHEN("A key is pressed in one of the windows") {
+         PressIn(LeftWindow);
+         root.Update({});
+
+         THEN("Only the gatherer that owns the window sees it") {
+            REQUIRE(inLeft->mTrigger == MetaOf<Keys::A>());
+            REQUIRE_FALSE(inRight->mTrigger);
+         }
+      }
+
+      WHEN("A key is pressed in a window nobody is bound to") {
+         PressIn(3000);
+         root.Update({});
+
+         THEN("All gatherers see it") {
+            REQUIRE(inLeft->mTrigger == MetaOf<Keys::A>());
+            REQUIRE(inRight->mTrigger == MetaOf<Keys::A>());
+         }
+      }
+
+      WHEN("A key is pressed outside of any window") {
+         PressIn(0);
+         root.Update({});
+
+         THEN("All gatherers see it") {
+            REQUIRE(inLeft->mTrigger == MetaOf<Keys::A>());
+            REQUIRE(inRight->mTrigger == MetaOf<Keys::A>());
+         }
+      }
+   }
+
+   // Check for memory leaks after each scenario                        
+   REQUIRE(memoryState.Assert());
+}